@@ -0,0 +1,148 @@
+// =====================
+// bench/bench_command_args.cpp
+// 명령 인자 파싱 비용 비교: 기존 istringstream >> / string_view 토크나이저 (parseArgs, from_chars)
+// 사용법: bench-command-args [반복 횟수]
+// =====================
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "server/CommandArgs.hpp"
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+} // namespace
+
+// 명령당 힙 할당 수를 세기 위해
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 최적화가 결과를 없애지 못하게
+volatile size_t sink;
+
+// 최적화 전 핸들러와 같은 방식 (비교 기준)
+size_t legacyGetHistory(std::string_view payload) {
+    std::istringstream iss{std::string(payload)};
+    std::string email;
+    int limit = 10, offset = 0;
+    iss >> email >> limit >> offset;
+    return email.size() + limit + offset;
+}
+
+size_t legacyAddHistory(std::string_view payload) {
+    std::istringstream iss{std::string(payload)};
+    std::string rawDate, imagePath, plateNumber, startSnapshot, endSnapshot;
+    int eventType;
+    float speed = -1;
+    iss >> rawDate >> imagePath >> plateNumber >> eventType >> startSnapshot >> endSnapshot >> speed;
+    return rawDate.size() + imagePath.size() + plateNumber.size() + eventType + endSnapshot.size() +
+           static_cast<size_t>(speed);
+}
+
+size_t legacyDateRange(std::string_view payload) {
+    std::istringstream iss{std::string(payload)};
+    std::string email, startDate, endDate;
+    int eventType = 0, limit = 10, offset = 0;
+    iss >> email >> eventType >> startDate >> endDate >> limit >> offset;
+    return email.size() + startDate.size() + endDate.size() + eventType + limit + offset;
+}
+
+size_t legacyUpload(std::string_view line) {
+    std::istringstream iss{std::string(line)};
+    std::string tag, filename;
+    size_t filesize = 0;
+    iss >> tag >> filename >> filesize;
+    return filename.size() + filesize;
+}
+
+size_t parsedGetHistory(std::string_view payload) {
+    std::string_view email;
+    int limit = 10, offset = 0;
+    parseArgs(payload, 1, email, limit, offset);
+    return email.size() + limit + offset;
+}
+
+size_t parsedAddHistory(std::string_view payload) {
+    std::string_view rawDate, imagePath, plateNumber, startSnapshot, endSnapshot;
+    int eventType = -1;
+    std::optional<float> speed;
+    parseArgs(payload, 4, rawDate, imagePath, plateNumber, eventType, startSnapshot, endSnapshot, speed);
+    return rawDate.size() + imagePath.size() + plateNumber.size() + eventType + endSnapshot.size() +
+           static_cast<size_t>(speed.value_or(-1));
+}
+
+size_t parsedDateRange(std::string_view payload) {
+    std::string_view email, startDate, endDate;
+    int eventType = 0, limit = 10, offset = 0;
+    parseArgs(payload, 4, email, eventType, startDate, endDate, limit, offset);
+    return email.size() + startDate.size() + endDate.size() + eventType + limit + offset;
+}
+
+size_t parsedUpload(std::string_view line) {
+    std::string_view filename;
+    size_t filesize = 0;
+    parseArgs(commandArgs(line), 2, filename, filesize);
+    return filename.size() + filesize;
+}
+
+struct Case {
+    const char*      name;
+    std::string_view input;
+    size_t (*legacy)(std::string_view);
+    size_t (*parsed)(std::string_view);
+};
+
+template <typename F>
+void measure(F parse, std::string_view input, int iterations, double& nsPerCmd, double& allocsPerCmd) {
+    size_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    size_t acc = 0;
+    for (int i = 0; i < iterations; ++i) acc += parse(input);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    sink = acc;
+    nsPerCmd = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    allocsPerCmd = static_cast<double>(allocations.load() - before) / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    const Case cases[] = {
+        {"GET_HISTORY", "user@example.com 10 0", legacyGetHistory, parsedGetHistory},
+        {"ADD_HISTORY",
+         "2025-01-01_12:00:00 images/img1.jpg 12가3456 1 images/s.jpg images/e.jpg 63.5",
+         legacyAddHistory, parsedAddHistory},
+        {"BY_TYPE_AND_DATE", "user@example.com 0 2025-01-01 2025-01-31 10 0", legacyDateRange,
+         parsedDateRange},
+        {"UPLOAD", "UPLOAD capture_20250101_120000.jpg 1048576\n", legacyUpload, parsedUpload},
+    };
+
+    std::printf("%d iterations per command\n", iterations);
+    std::printf("%-18s %14s %14s %16s %16s\n", "command", "istringstream", "parseArgs", "allocs (legacy)",
+                "allocs (parse)");
+    for (const Case& c : cases) {
+        double legacyNs, legacyAllocs, parsedNs, parsedAllocs;
+        measure(c.legacy, c.input, iterations, legacyNs, legacyAllocs);
+        measure(c.parsed, c.input, iterations, parsedNs, parsedAllocs);
+        std::printf("%-18s %11.1f ns %11.1f ns %16.1f %16.1f\n", c.name, legacyNs, parsedNs, legacyAllocs,
+                    parsedAllocs);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+// =====================
+// bench/bench_history_insert.cpp
+// 히스토리 저장 처리량 비교: 건마다 createHistory (자동 커밋) / createHistories 묶음 (트랜잭션 하나)
+// 파일 DB 를 쓰므로 커밋마다의 디스크 동기화 비용이 그대로 드러난다 (SD 카드에서 차이가 가장 큼)
+// 사용법: bench-history-insert [건수] [DB 경로]
+// =====================
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "db/DBInitializer.hpp"
+#include "db/DBManager.hpp"
+#include "db/repository/HistoryRepository.hpp"
+
+namespace {
+
+std::vector<History> makeRecords(int count) {
+    std::vector<History> records(count);
+    char date[32], image[64], plate[32];
+    for (int i = 0; i < count; ++i) {
+        std::snprintf(date, sizeof(date), "2025-01-%02d %02d:%02d:%02d", 1 + i % 28, i % 24, i % 60, i % 59);
+        std::snprintf(image, sizeof(image), "images/event_%06d.jpg", i);
+        std::snprintf(plate, sizeof(plate), "%02d가%04d", i % 100, i % 10000);
+        History& h = records[i];
+        h.date = date;
+        h.imagePath = image;
+        h.plateNumber = plate;
+        h.eventType = i % 3;
+        if (h.eventType == 1) h.speed = 40.0f + (i % 700) / 7.0f;
+    }
+    return records;
+}
+
+// 묶음 크기 batch 로 records 를 모두 저장하는 데 걸린 초 (batch 0 은 건마다 createHistory)
+double run(HistoryRepository& repo, const std::vector<History>& records, size_t batch) {
+    auto start = std::chrono::steady_clock::now();
+    if (batch == 0) {
+        for (const History& h : records) repo.createHistory(h);
+    } else {
+        std::vector<int> ids;
+        for (size_t i = 0; i < records.size(); i += batch) {
+            std::vector<History> chunk(records.begin() + i,
+                                       records.begin() + std::min(records.size(), i + batch));
+            repo.createHistories(chunk, ids);
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000;
+    std::string path = argc > 2 ? argv[2] : "bench_history.db";
+
+    std::remove(path.c_str());
+    DBManager db(path);
+    if (!db.open()) {
+        std::fprintf(stderr, "failed to open %s\n", path.c_str());
+        return 1;
+    }
+    DBInitializer::init(db);
+    HistoryRepository repo(db.getDB());
+    std::vector<History> records = makeRecords(count);
+
+    std::printf("%d records into %s\n", count, path.c_str());
+    const struct { const char* name; size_t batch; } modes[] = {
+        {"single", 0}, {"batch-10", 10}, {"batch-100", 100}, {"batch-1000", 1000},
+    };
+    double single = 0;
+    for (const auto& mode : modes) {
+        double sec = run(repo, records, mode.batch);
+        if (mode.batch == 0) single = sec;
+        std::printf("%-12s %10.0f records/s  %8.1f ms  x%.1f\n", mode.name, count / sec, sec * 1000, single / sec);
+    }
+
+    db.close();
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,173 @@
+// =====================
+// bench/bench_history_json.cpp
+// 히스토리 조회 응답 직렬화 비교: 기존 nlohmann DOM (행 목록 → 트리 → dump) / 커서에서 바로 쓰는 JsonWriter
+// 두 경로의 응답이 바이트 단위로 같은지도 확인한다
+// 사용법: bench-history-json [반복 횟수]
+// =====================
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include <json.hpp>
+
+#include "db/DBInitializer.hpp"
+#include "db/DBManager.hpp"
+#include "db/repository/HistoryRepository.hpp"
+#include "db/repository/UserRepository.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/CommandHandler.hpp"
+#include "server/RequestArena.hpp"
+
+// TcpServer.cpp 가 참조하는 전역 핸들러
+CommandHandler* commandHandler = nullptr;
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+} // namespace
+
+// 페이지당 힙 할당 수를 세기 위해
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+using ArenaJson = nlohmann::basic_json<std::map, std::vector, ArenaString, bool,
+                                       std::int64_t, std::uint64_t, double, ArenaAllocator>;
+
+// 최적화 전 handleGetHistory 와 같은 방식 (비교 기준)
+std::string legacyGetHistory(UserRepository& userRepo, HistoryRepository& historyRepo, std::string_view payload) {
+    RequestArena::Scope arena;
+    std::string_view email;
+    int limit = 10;
+    int offset = 0;
+    if (!parseArgs(payload, 1, email, limit, offset) || limit <= 0 || offset < 0) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
+    if (!userRepo.getUserByEmail(email).has_value()) {
+        return R"({"status": "error", "code": 404, "message": "User not found"})";
+    }
+
+    auto history = historyRepo.getHistories(limit, offset);
+
+    ArenaJson data = ArenaJson::array();
+    for (const auto& h : history) {
+        std::string start_snapshot, end_snapshot;
+        ArenaJson speed_json;
+
+        if (h.eventType == 0) {
+            start_snapshot = h.startSnapshot;
+            end_snapshot = h.endSnapshot;
+            speed_json = nullptr;
+        } else if (h.eventType == 1) {
+            start_snapshot = "";
+            end_snapshot = "";
+            if (h.speed.has_value()) {
+                float rounded = std::round(h.speed.value() * 100) / 100.0f;
+                speed_json = rounded;
+            } else {
+                speed_json = nullptr;
+            }
+        } else {
+            start_snapshot = "";
+            end_snapshot = "";
+            speed_json = nullptr;
+        }
+
+        data.push_back({
+            {"id", h.id},
+            {"date", h.date},
+            {"image_path", h.imagePath},
+            {"plate_number", h.plateNumber},
+            {"event_type", h.eventType},
+            {"start_snapshot", start_snapshot},
+            {"end_snapshot", end_snapshot},
+            {"speed", speed_json}
+        });
+    }
+
+    ArenaJson response = {
+        {"status", "success"},
+        {"code", 200},
+        {"message", "History retrieved successfully"},
+        {"data", data}
+    };
+    ArenaString out = response.dump();
+    return std::string(out.data(), out.size());
+}
+
+// 유형, 속도, 멀티바이트 번호판, 이스케이프가 필요한 경로가 섞인 행
+void fill(HistoryRepository& repo, int rows) {
+    char date[32], image[64], plate[32];
+    for (int i = 0; i < rows; ++i) {
+        std::snprintf(date, sizeof(date), "2025-01-%02d %02d:%02d:%02d", 1 + i % 28, i % 24, i % 60, i % 59);
+        std::snprintf(image, sizeof(image), i % 50 == 0 ? "images/\"cam\\%d\".jpg" : "images/event_%06d.jpg", i);
+        std::snprintf(plate, sizeof(plate), "%02d가%04d", i % 100, i % 10000);
+        History h;
+        h.date = date;
+        h.imagePath = image;
+        h.plateNumber = plate;
+        h.eventType = i % 3;
+        h.startSnapshot = h.eventType == 0 ? "images/start.jpg" : "";
+        h.endSnapshot = h.eventType == 0 ? "images/end.jpg" : "";
+        if (h.eventType == 1) h.speed = 40.0f + (i % 700) / 7.0f;
+        repo.createHistory(h);
+    }
+}
+
+template <typename F>
+void measure(F run, int iterations, double& usPerPage, double& allocsPerPage, size_t& bytes) {
+    size_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) bytes = run().size();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    usPerPage = std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+    allocsPerPage = static_cast<double>(allocations.load() - before) / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+    DBManager db(":memory:");
+    if (!db.open()) {
+        std::fprintf(stderr, "failed to open database\n");
+        return 1;
+    }
+    DBInitializer::init(db);
+    CommandHandler handler(db.getDB(), nullptr);
+    UserRepository userRepo(db.getDB());
+    HistoryRepository historyRepo(db.getDB());
+    handler.handle("REGISTER bench@example.com pw");
+    fill(historyRepo, 1000);
+
+    std::printf("%d iterations per page\n", iterations);
+    std::printf("%-6s %12s %12s %14s %14s %10s %s\n", "rows", "dom", "stream", "allocs (dom)",
+                "allocs (stream)", "bytes", "identical");
+    for (int rows : {10, 100, 1000}) {
+        std::string payload = "bench@example.com " + std::to_string(rows) + " 0";
+        std::string command = "GET_HISTORY " + payload;
+        std::string legacy = legacyGetHistory(userRepo, historyRepo, payload);
+        std::string streamed = handler.handle(command);
+
+        double domUs, domAllocs, streamUs, streamAllocs;
+        size_t bytes = 0;
+        measure([&] { return legacyGetHistory(userRepo, historyRepo, payload); }, iterations, domUs, domAllocs, bytes);
+        measure([&] { return handler.handle(command); }, iterations, streamUs, streamAllocs, bytes);
+        std::printf("%-6d %9.1f us %9.1f us %14.1f %14.1f %10zu %s\n", rows, domUs, streamUs, domAllocs,
+                    streamAllocs, bytes, legacy == streamed ? "yes" : "NO");
+        if (legacy != streamed) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// =====================
+// bench/bench_history_page.cpp
+// 깊은 페이지 조회 비교: LIMIT/OFFSET (getHistories) / (date, id) 키셋 커서 (getHistoriesPage)
+// OFFSET 은 앞의 행을 모두 건너뛰어야 해서 깊이에 비례하고, 키셋은 인덱스에서 바로 찾아 깊이와 무관하다
+// 사용법: bench-history-page [행 수] [DB 경로]   (예: 1000000, 10000000)
+// =====================
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sqlite3.h>
+
+#include "db/DBInitializer.hpp"
+#include "db/DBManager.hpp"
+#include "db/repository/HistoryRepository.hpp"
+
+namespace {
+
+constexpr int kPageSize = 20;
+
+// 재귀 CTE 로 한 번에 채운다. 두 행씩 같은 시각이라 (date, id) 동률 처리도 거친다
+bool fill(sqlite3* db, long long rows) {
+    std::string sql =
+        "WITH RECURSIVE seq(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM seq WHERE x + 1 < " +
+        std::to_string(rows) + ") "
+        "INSERT INTO history (date, image_path, plate_number, event_type, speed) "
+        "SELECT strftime('%Y-%m-%d %H:%M:%S', '2020-01-01', '+' || (x / 2) || ' seconds'), "
+        "'images/event_' || x || '.jpg', printf('%02d가%04d', x % 100, x % 10000), x % 3, "
+        "CASE WHEN x % 3 = 1 THEN 40 + (x % 700) / 7.0 END FROM seq;";
+    char* err = nullptr;
+    if (sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) != SQLITE_OK ||
+        sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK ||
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::fprintf(stderr, "fill failed: %s\n", err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return false;
+    }
+    return true;
+}
+
+template <typename F>
+double averageMs(F run, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) run();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long long rows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "bench_history_page.db";
+
+    std::remove(path.c_str());
+    DBManager db(path);
+    if (!db.open()) {
+        std::fprintf(stderr, "failed to open %s\n", path.c_str());
+        return 1;
+    }
+    DBInitializer::init(db);
+    HistoryRepository repo(db.getDB());
+
+    auto fillStart = std::chrono::steady_clock::now();
+    if (!fill(db.getDB(), rows)) return 1;
+    std::printf("%lld rows into %s (%.1f s)\n", rows, path.c_str(),
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - fillStart).count());
+
+    std::printf("%-10s %12s %12s %8s %s\n", "depth", "offset", "keyset", "x", "same page");
+    for (double fraction : {0.0, 0.001, 0.01, 0.1, 0.5, 0.99}) {
+        int depth = static_cast<int>(rows * fraction);
+        if (fraction > 0 && depth == 0) continue;
+
+        // 같은 페이지를 가리키는 커서: depth 번째 행 바로 앞 행 (측정 밖에서 한 번)
+        std::string cursorDate;
+        HistoryCursor cursor;
+        if (depth > 0) {
+            repo.getHistories(1, depth - 1, [&](const HistoryRow& h) {
+                cursorDate.assign(h.date);
+                cursor.id = h.id;
+                return true;
+            });
+            cursor.date = cursorDate;
+        }
+        const HistoryCursor* after = depth > 0 ? &cursor : nullptr;
+
+        int offsetFirst = -1, keysetFirst = -2;
+        int iterations = fraction >= 0.1 ? 3 : 20;
+        double offsetMs = averageMs([&] {
+            repo.getHistories(kPageSize, depth, [&](const HistoryRow& h) {
+                if (offsetFirst < 0) offsetFirst = h.id;
+                return true;
+            });
+        }, iterations);
+        double keysetMs = averageMs([&] {
+            repo.getHistoriesPage(after, kPageSize, [&](const HistoryRow& h) {
+                if (keysetFirst < 0) keysetFirst = h.id;
+                return true;
+            });
+        }, iterations);
+        std::printf("%-10d %9.3f ms %9.3f ms %8.0f %s\n", depth, offsetMs, keysetMs, offsetMs / keysetMs,
+                    offsetFirst == keysetFirst ? "yes" : "NO");
+        if (offsetFirst != keysetFirst) return 1;
+    }
+
+    db.close();
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,120 @@
+// =====================
+// bench/bench_history_stats.cpp
+// 기간·유형별 건수 조회 비교: history 를 날짜 범위로 읽어 GROUP BY / 트리거가 유지하는 history_stats 롤업 (getStats)
+// 롤업이 없던 DB 를 처음 시작할 때의 채우기 시간도 잰다
+// 사용법: bench-history-stats [행 수] [DB 경로]
+// =====================
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <sqlite3.h>
+
+#include "db/DBInitializer.hpp"
+#include "db/DBManager.hpp"
+#include "db/repository/HistoryRepository.hpp"
+
+namespace {
+
+// 재귀 CTE 로 한 번에 채운다 (30초 간격, 100만 행이면 약 347일). 롤업은 INSERT 트리거가 같이 갱신한다
+bool fill(sqlite3* db, long long rows) {
+    std::string sql =
+        "WITH RECURSIVE seq(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM seq WHERE x + 1 < " +
+        std::to_string(rows) + ") "
+        "INSERT INTO history (date, image_path, plate_number, event_type, speed) "
+        "SELECT strftime('%Y-%m-%d %H:%M:%S', '2024-01-01', '+' || (x * 30) || ' seconds'), "
+        "'images/event_' || x || '.jpg', printf('%02d가%04d', x % 100, x % 10000), x % 3, "
+        "CASE WHEN x % 3 = 1 THEN 40 + (x % 700) / 7.0 END FROM seq;";
+    char* err = nullptr;
+    if (sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr) != SQLITE_OK ||
+        sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK ||
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::fprintf(stderr, "fill failed: %s\n", err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return false;
+    }
+    return true;
+}
+
+// 롤업 없이 원본 행을 세는 방식 (비교 기준). 반환값은 전체 건수
+long long scanStats(sqlite3* db, const std::string& start, const std::string& end) {
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(db,
+        "SELECT substr(date, 1, 10), event_type, COUNT(*) FROM history "
+        "WHERE date BETWEEN ?1 || ' 00:00:00' AND ?2 || ' 23:59:59' GROUP BY 1, 2 ORDER BY 1, 2;",
+        -1, &stmt, nullptr);
+    sqlite3_bind_text(stmt, 1, start.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, end.c_str(), -1, SQLITE_TRANSIENT);
+    long long total = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) total += sqlite3_column_int64(stmt, 2);
+    sqlite3_finalize(stmt);
+    return total;
+}
+
+long long rollupStats(HistoryRepository& repo, const std::string& start, const std::string& end) {
+    long long total = 0;
+    repo.getStats(start, end, false, [&](const HistoryStatsRow& row) {
+        total += row.count;
+        return true;
+    });
+    return total;
+}
+
+template <typename F>
+double averageMs(F run, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) run();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long long rows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "bench_history_stats.db";
+
+    std::remove(path.c_str());
+    DBManager db(path);
+    if (!db.open()) {
+        std::fprintf(stderr, "failed to open %s\n", path.c_str());
+        return 1;
+    }
+    DBInitializer::init(db);
+    HistoryRepository repo(db.getDB());
+
+    auto start = std::chrono::steady_clock::now();
+    if (!fill(db.getDB(), rows)) return 1;
+    std::printf("%lld rows into %s (%.1f s with rollup triggers)\n", rows, path.c_str(), secondsSince(start));
+
+    // 롤업 이전 DB 로 되돌려 시작 시 채우기
+    db.execute("DROP TRIGGER trg_history_stats_insert; DROP TRIGGER trg_history_stats_delete;"
+               "DROP TRIGGER trg_history_stats_update; DROP TABLE history_stats;");
+    start = std::chrono::steady_clock::now();
+    DBInitializer::init(db);
+    std::printf("backfill on first start: %.2f s\n", secondsSince(start));
+
+    std::printf("%-22s %12s %12s %8s %s\n", "range", "scan", "rollup", "x", "same total");
+    const struct { const char* name; const char* start; const char* end; } ranges[] = {
+        {"1 day", "2024-06-01", "2024-06-01"},
+        {"7 days", "2024-06-01", "2024-06-07"},
+        {"30 days", "2024-06-01", "2024-06-30"},
+        {"all", "2000-01-01", "2099-12-31"},
+    };
+    for (const auto& range : ranges) {
+        long long scanTotal = 0, rollupTotal = 0;
+        double scanMs = averageMs([&] { scanTotal = scanStats(db.getDB(), range.start, range.end); }, 5);
+        double rollupMs = averageMs([&] { rollupTotal = rollupStats(repo, range.start, range.end); }, 5);
+        std::printf("%-22s %9.3f ms %9.3f ms %8.0f %s (%lld)\n", range.name, scanMs, rollupMs, scanMs / rollupMs,
+                    scanTotal == rollupTotal ? "yes" : "NO", rollupTotal);
+        if (scanTotal != rollupTotal) return 1;
+    }
+
+    db.close();
+    std::remove(path.c_str());
+    return 0;
+}
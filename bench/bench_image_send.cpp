@@ -0,0 +1,196 @@
+// =====================
+// bench/bench_image_send.cpp
+// GET_IMAGE 본문 전송 경로 비교: 기존 4KB ifstream / 64KB 버퍼 / io_uring 선읽기 / kTLS SSL_sendfile
+// 사용법: bench-image-send [파일 크기 MB] [반복 횟수]
+// =====================
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <ctime>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "server/ImageHandler.hpp"
+#include "server/IoUring.hpp"
+#include "util/EndianUtils.hpp"
+
+namespace {
+
+const char* kImagePath = "bench_image.bin";
+
+enum class Path { Legacy4K, Buffered, Uring, Ktls };
+
+// 벤치마크용 자체 서명 EC 인증서
+SSL_CTX* makeServerCtx(bool ktls) {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME_add_entry_by_txt(X509_get_subject_name(cert), "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("bench"), -1, -1, 0);
+    X509_set_issuer_name(cert, X509_get_subject_name(cert));
+    X509_sign(cert, key, EVP_sha256());
+    SSL_CTX_use_certificate(ctx, cert);
+    SSL_CTX_use_PrivateKey(ctx, key);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+#ifdef SSL_OP_ENABLE_KTLS
+    if (ktls) SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+#endif
+    return ctx;
+}
+
+// 최적화 전 handleGetImage 와 같은 방식 (비교 기준)
+void sendLegacy(SSL* ssl, const std::string& imagePath) {
+    std::ifstream file(imagePath, std::ios::binary);
+    file.seekg(0, std::ios::end);
+    size_t fileSize = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    uint64_t netFileSize = htonll(fileSize);
+    SSL_write(ssl, &netFileSize, sizeof(netFileSize));
+
+    char buffer[4096];
+    while (!file.eof()) {
+        file.read(buffer, sizeof(buffer));
+        std::streamsize bytesRead = file.gcount();
+        if (bytesRead > 0) SSL_write(ssl, buffer, bytesRead);
+    }
+}
+
+struct Result {
+    bool   ok = false;
+    double wallSec = 0;
+    double serverCpuSec = 0;
+    size_t bytes = 0;
+};
+
+double threadCpuSec() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 루프백으로 TLS 연결 하나를 맺고 이미지를 iterations 번 보낸다
+Result run(Path path, int iterations) {
+    Result result;
+    SSL_CTX* sctx = makeServerCtx(path == Path::Ktls);
+    SSL_CTX* cctx = SSL_CTX_new(TLS_client_method());
+
+    int lfd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(lfd, 1);
+    getsockname(lfd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    // 클라이언트: 길이 헤더 + 본문을 읽고 버린다
+    std::thread client([&] {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        SSL* ssl = SSL_new(cctx);
+        SSL_set_fd(ssl, fd);
+        if (SSL_connect(ssl) == 1) {
+            std::vector<char> buf(256 * 1024);
+            for (int i = 0; i < iterations; ++i) {
+                uint64_t netSize = 0;
+                if (SSL_read(ssl, &netSize, sizeof(netSize)) != sizeof(netSize)) break;
+                size_t remaining = ntohll(netSize);
+                while (remaining > 0) {
+                    int n = SSL_read(ssl, buf.data(), std::min(buf.size(), remaining));
+                    if (n <= 0) break;
+                    remaining -= n;
+                    result.bytes += n;
+                }
+            }
+        }
+        SSL_free(ssl);
+        close(fd);
+    });
+
+    int cfd = accept(lfd, nullptr, nullptr);
+    SSL* ssl = SSL_new(sctx);
+    SSL_set_fd(ssl, cfd);
+    if (SSL_accept(ssl) == 1 &&
+        (path != Path::Ktls || ImageHandler::ktlsSendEnabled(ssl)) &&
+        (path != Path::Uring || IoUring::supported())) {
+        ImageHandler handler(nullptr);
+        handler.setIoUring(path == Path::Uring);
+        auto start = std::chrono::steady_clock::now();
+        double cpuStart = threadCpuSec();
+        for (int i = 0; i < iterations; ++i) {
+            if (path == Path::Legacy4K) {
+                sendLegacy(ssl, kImagePath);
+            } else {
+                handler.handleGetImage(ssl, kImagePath);
+            }
+        }
+        result.serverCpuSec = threadCpuSec() - cpuStart;
+        client.join();
+        result.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.ok = true;
+    } else {
+        shutdown(cfd, SHUT_RDWR);
+        client.join();
+    }
+
+    SSL_free(ssl);
+    close(cfd);
+    close(lfd);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    ERR_clear_error();
+    return result;
+}
+
+void report(const char* name, const Result& r) {
+    if (!r.ok) {
+        std::printf("%-14s unavailable (not supported by this kernel)\n", name);
+        return;
+    }
+    double mb = r.bytes / (1024.0 * 1024.0);
+    std::printf("%-14s %8.1f MB/s  %7.3f server CPU ms/MB\n",
+                name, mb / r.wallSec, r.serverCpuSec * 1000.0 / mb);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t sizeMb  = argc > 1 ? std::atoi(argv[1]) : 8;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 16;
+
+    {
+        std::ofstream ofs(kImagePath, std::ios::binary);
+        std::vector<char> chunk(1024 * 1024);
+        for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = static_cast<char>(i * 31);
+        for (size_t i = 0; i < sizeMb; ++i) ofs.write(chunk.data(), chunk.size());
+    }
+
+    std::printf("image %zu MB x %d\n", sizeMb, iterations);
+    report("legacy-4k", run(Path::Legacy4K, iterations));
+    report("buffered-64k", run(Path::Buffered, iterations));
+    report("uring-64k", run(Path::Uring, iterations));
+    report("ktls-sendfile", run(Path::Ktls, iterations));
+
+    std::remove(kImagePath);
+    return 0;
+}
@@ -2,6 +2,7 @@
 #define HISTORY_HPP
 
 #include <string>
+#include <string_view>
 #include <optional>
 struct History {
     std::string date;         // "YYYY-MM-DD HH:MM:SS"
@@ -15,4 +16,29 @@ struct History {
     int id = -1;
 };
 
+// 조회 visitor 에 넘기는 행. 문자열은 SQLite 커서의 버퍼를 가리켜 visit 안에서만 유효하다
+struct HistoryRow {
+    int id = -1;
+    std::string_view date;
+    std::string_view imagePath;
+    std::string_view plateNumber;
+    int eventType = 0;
+    std::string_view startSnapshot;
+    std::string_view endSnapshot;
+    std::optional<float> speed;
+};
+
+// 키셋 페이지 위치. (date, id) 내림차순에서 이 행 다음부터
+struct HistoryCursor {
+    std::string_view date;
+    int id = -1;
+};
+
+// 기간 (일 "YYYY-MM-DD" 또는 시간 "YYYY-MM-DD HH:00")·유형별 건수 (history_stats 롤업)
+struct HistoryStatsRow {
+    std::string_view period;
+    int eventType = 0;
+    long long count = 0;
+};
+
 #endif // HISTORY_HPP
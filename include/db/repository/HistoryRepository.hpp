@@ -1,8 +1,10 @@
 #ifndef HISTORY_REPOSITORY_HPP
 #define HISTORY_REPOSITORY_HPP
 
+#include <functional>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sqlite3.h>
 #include "../model/History.hpp"
 
@@ -13,6 +15,15 @@ public:
     // 히스토리 생성
     bool createHistory(const History& history);
 
+    // 여러 건을 트랜잭션 하나로 생성 (준비된 INSERT 재사용). ids 에 건별 새 id, 실패한 건은 -1.
+    // 트랜잭션을 시작하거나 커밋하지 못했거나 도중에 SQLite 가 트랜잭션을 되돌렸으면 false (아무것도 반영되지 않음).
+    // 실행하는 동안 연결을 잡아 다른 스레드의 문장이 이 트랜잭션에 섞이지 않는다
+    bool createHistories(const std::vector<History>& histories, std::vector<int>& ids);
+
+    // 커밋된 INSERT 마다 id 를 채운 사본으로 호출 (createHistory 를 부른 스레드에서)
+    using InsertListener = std::function<void(const History&)>;
+    void setInsertListener(InsertListener listener);
+
     // 페이지네이션 적용한 히스토리 조회 (limit & offset)
     std::vector<History> getHistories(int limit, int offset);
 
@@ -25,11 +36,56 @@ public:
     // 이벤트 유형 + 날짜 범위 필터 + 페이지네이션
     std::vector<History> getHistoriesByEventTypeAndDateRange(int eventType, const std::string& startDate, const std::string& endDate, int limit, int offset);
 
+    // 위 조회와 같되 행을 모으지 않고 SQLite 커서에서 바로 visit 에 넘긴다 (큰 페이지도 행 하나 분량만 잡음).
+    // 행의 문자열은 visit 안에서만 유효하다. visit 이 false 를 돌려주면 거기서 멈춘다.
+    // SQLite 가 문장을 준비하거나 읽다가 실패했을 때만 false (그때까지 넘긴 행은 일부뿐)
+    using RowVisitor = std::function<bool(const HistoryRow&)>;
+    bool getHistories(int limit, int offset, const RowVisitor& visit);
+    bool getHistoriesByEventType(int eventType, int limit, int offset, const RowVisitor& visit);
+    bool getHistoriesByDateRange(std::string_view startDate, std::string_view endDate, int limit, int offset,
+                                 const RowVisitor& visit);
+    bool getHistoriesByEventTypeAndDateRange(int eventType, std::string_view startDate, std::string_view endDate,
+                                             int limit, int offset, const RowVisitor& visit);
+
+    // 키셋 페이지네이션: (date, id) 내림차순으로 after 다음 행부터 최대 limit 개 (after 가 nullptr 이면 처음부터).
+    // OFFSET 처럼 앞 행을 건너뛰며 읽지 않고 인덱스에서 바로 시작하므로 페이지 깊이와 무관하게 일정하고,
+    // 넘기는 사이에 새 행이 들어와도 페이지가 밀리지 않는다
+    bool getHistoriesPage(const HistoryCursor* after, int limit, const RowVisitor& visit);
+    bool getHistoriesByEventTypePage(int eventType, const HistoryCursor* after, int limit, const RowVisitor& visit);
+    bool getHistoriesByDateRangePage(std::string_view startDate, std::string_view endDate,
+                                     const HistoryCursor* after, int limit, const RowVisitor& visit);
+    bool getHistoriesByEventTypeAndDateRangePage(int eventType, std::string_view startDate, std::string_view endDate,
+                                                 const HistoryCursor* after, int limit, const RowVisitor& visit);
+
+    // id 가 lastId 보다 큰 행을 id 오름차순으로 최대 limit 개 (변경 피드 커서, 기본 키 범위 탐색)
+    bool getHistoriesSince(int lastId, int limit, const RowVisitor& visit);
+
+    // startDate ~ endDate (YYYY-MM-DD, 양 끝 포함) 의 기간·유형별 건수를 기간, 유형 순으로 visit 에 넘긴다.
+    // hourly 면 시간 단위, 아니면 일 단위. 트리거가 유지하는 롤업에서 읽으므로 비용은 행 수가 아니라 기간 길이에 비례.
+    // 반환값은 위 조회와 같다 (SQLite 실패일 때만 false)
+    using StatsVisitor = std::function<bool(const HistoryStatsRow&)>;
+    bool getStats(std::string_view startDate, std::string_view endDate, bool hourly, const StatsVisitor& visit);
+
     // 특정 ID의 히스토리 삭제
     bool deleteHistory(int id);
 
 private:
+    // 조회별 SELECT 를 준비하고 인자를 바인딩 (실패하면 nullptr)
+    sqlite3_stmt* selectHistories(int limit, int offset);
+    sqlite3_stmt* selectByEventType(int eventType, int limit, int offset);
+    sqlite3_stmt* selectByDateRange(std::string_view startDate, std::string_view endDate, int limit, int offset);
+    sqlite3_stmt* selectByEventTypeAndDateRange(int eventType, std::string_view startDate,
+                                                std::string_view endDate, int limit, int offset);
+    sqlite3_stmt* selectSince(int lastId, int limit);
+    // 키셋 페이지 SELECT. eventType, 날짜 범위 (startDate 가 nullptr 이 아니면), after 는 있을 때만 조건에 넣는다
+    sqlite3_stmt* selectPage(const int* eventType, const std::string_view* startDate, const std::string_view* endDate,
+                             const HistoryCursor* after, int limit);
+
+    // 준비된 SELECT 의 행을 복사 없이 visit 에 넘기고 stmt 를 정리. 끝까지 또는 visit 이 멈출 때까지 읽었으면 true
+    bool visitRows(sqlite3_stmt* stmt, const RowVisitor& visit);
+
     sqlite3* db;
+    InsertListener onInsert;
 };
 
 #endif // HISTORY_REPOSITORY_HPP
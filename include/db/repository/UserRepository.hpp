@@ -2,6 +2,7 @@
 #define USER_REPOSITORY_HPP
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include "../model/User.hpp"
 #include "sqlite3.h"
@@ -11,7 +12,7 @@ public:
     explicit UserRepository(sqlite3* db);
 
     bool createUser(const User& user);
-    std::optional<User> getUserByEmail(const std::string& email);
+    std::optional<User> getUserByEmail(std::string_view email);
     std::optional<User> getUserById(int id);
     bool updateUserPassword(int id, const std::string& newPasswordHash);
     bool deleteUser(int id);
@@ -0,0 +1,70 @@
+#ifndef ASYNC_HPP
+#define ASYNC_HPP
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// 코루틴 모드의 최소 실행 계층.
+//
+// Async<T>: co_await 할 때 시작되는 지연 코루틴. 끝나면 기다리던 코루틴을
+//           대칭 전환(symmetric transfer)으로 바로 이어서 실행한다.
+// Detached: 연결 하나를 끝까지 처리하는 최상위 코루틴. 호출 즉시 시작하고
+//           끝나면 프레임이 스스로 해제된다.
+template <typename T>
+class Async {
+public:
+    struct promise_type {
+        std::optional<T>        value;
+        std::coroutine_handle<> continuation;
+
+        Async get_return_object() {
+            return Async(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                auto next = h.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(T v) { value = std::move(v); }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Async(std::coroutine_handle<promise_type> h) : handle(h) {}
+    Async(Async&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Async(const Async&) = delete;
+    Async& operator=(const Async&) = delete;
+    ~Async() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    T await_resume() { return std::move(*handle.promise().value); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+#endif // ASYNC_HPP
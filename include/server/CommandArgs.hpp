@@ -0,0 +1,70 @@
+#ifndef COMMAND_ARGS_HPP
+#define COMMAND_ARGS_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+// 명령 인자 토크나이저. 인자 문자열을 복사하지 않고 공백으로 나눈 토큰을 string_view 로 돌려주고,
+// 숫자는 std::from_chars 로 읽는다 (로캘 무관, 토큰 전체가 숫자여야 함).
+// istringstream 과 달리 형식이 틀린 토큰을 기본값으로 남겨 두지 않고 실패로 알린다.
+class ArgReader {
+public:
+    explicit ArgReader(std::string_view args) : rest(args) {}
+
+    // 다음 토큰 (공백, 탭, 개행으로 구분). 없으면 false
+    bool next(std::string_view& token);
+    // 다음 토큰을 value 로. 토큰이 없거나 형식이 틀리면 false
+    template <typename T>
+    bool read(T& value);
+    // 남은 토큰이 없는지
+    bool done();
+
+private:
+    std::string_view rest;
+};
+
+// YYYY-MM-DD 날짜 (월 01-12, 일 01-31). 값은 토큰 그대로 (DB 의 날짜 문자열과 바로 비교)
+struct DateArg {
+    std::string_view value;
+};
+
+// 토큰 하나를 값으로. 형식이 틀리면 false
+bool parseArg(std::string_view token, std::string_view& value);
+bool parseArg(std::string_view token, int& value);
+bool parseArg(std::string_view token, size_t& value);
+bool parseArg(std::string_view token, float& value);            // 유한한 값만
+bool parseArg(std::string_view token, std::optional<float>& value);  // "-" 는 값 없음
+bool parseArg(std::string_view token, DateArg& value);
+
+template <typename T>
+bool ArgReader::read(T& value) {
+    std::string_view token;
+    return next(token) && parseArg(token, value);
+}
+
+// 명령별 인자 스키마: values 의 타입 순서대로 읽는다. 앞의 required 개는 필수, 나머지는 있으면 읽고
+// 없으면 호출자가 넣어 둔 기본값을 둔다. 토큰이 모자라거나 남거나 하나라도 형식이 틀리면 false
+template <typename... T>
+bool parseArgs(std::string_view args, size_t required, T&... values) {
+    ArgReader reader(args);
+    size_t index = 0;
+    bool ok = true;
+    auto one = [&](auto& value) {
+        if (!ok) return;
+        std::string_view token;
+        if (reader.next(token)) {
+            ok = parseArg(token, value);
+        } else {
+            ok = index >= required;
+        }
+        ++index;
+    };
+    (one(values), ...);
+    return ok && reader.done();
+}
+
+// 명령 줄에서 명령 이름 뒤의 인자 부분 (첫 개행 앞까지)
+std::string_view commandArgs(std::string_view line);
+
+#endif // COMMAND_ARGS_HPP
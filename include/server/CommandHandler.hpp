@@ -5,6 +5,7 @@
 #define COMMAND_HANDLER_HPP
 
 #include <string>
+#include <string_view>
 #include <sqlite3.h>
 #include <openssl/ssl.h>
 #include "../db/repository/UserRepository.hpp"
@@ -16,6 +17,9 @@ public:
     CommandHandler(sqlite3* db, ImageHandler* ih);
 
     std::string handle(const std::string& commandStr);
+
+    // 상태를 바꾸지 않는 조회 명령인지 (파이프라인에서 동시 실행 가능)
+    static bool isReadOnly(std::string_view commandStr);
     void handleGetImage(SSL* ssl, const std::string& imagePath);
 
 private:
@@ -23,17 +27,25 @@ private:
     HistoryRepository historyRepo;
     ImageHandler* imageHandler_;
 
-    std::string handleRegister(const std::string& payload);
-    std::string handleLogin(const std::string& payload);
-    std::string handleResetPassword(const std::string& payload);
-    std::string handleGetHistory(const std::string& payload);
-    std::string handleAddHistory(const std::string& payload);
-    std::string handleGetHistoryByEventType(const std::string& payload);
-    std::string handleGetHistoryByDateRange(const std::string& payload);
-    std::string handleGetHistoryByEventTypeAndDateRange(const std::string& payload);
-    std::string handleChangeFrame(const std::string& payload);
-    std::string handleGetFrame(const std::string& payload);
-    std::string handleGetLog(const std::string& payload);
+    std::string handleRegister(std::string_view payload);
+    std::string handleLogin(std::string_view payload);
+    std::string handleResetPassword(std::string_view payload);
+    std::string handleGetHistory(std::string_view payload);
+    std::string handleAddHistory(std::string_view payload);
+    std::string handleAddHistoryBatch(std::string_view payload);
+    std::string handleGetHistoryByEventType(std::string_view payload);
+    std::string handleGetHistoryByDateRange(std::string_view payload);
+    std::string handleGetHistoryByEventTypeAndDateRange(std::string_view payload);
+    std::string handleGetHistoryPage(std::string_view payload);
+    std::string handleGetHistoryByEventTypePage(std::string_view payload);
+    std::string handleGetHistoryByDateRangePage(std::string_view payload);
+    std::string handleGetHistoryByEventTypeAndDateRangePage(std::string_view payload);
+    std::string handleGetHistorySince(std::string_view payload);
+    std::string handleGetStats(std::string_view payload);
+    std::string handleChangeFrame(std::string_view payload);
+    std::string handleGetFrame(std::string_view payload);
+    std::string handleGetLog(std::string_view payload);
+    std::string handleGetMetrics(std::string_view payload);
 };
 
 #endif // COMMAND_HANDLER_HPP
\ No newline at end of file
@@ -0,0 +1,176 @@
+#ifndef COMMAND_TABLE_HPP
+#define COMMAND_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "server/ReadBuffer.hpp"
+
+// 텍스트 명령 표. 명령 이름 → 종류와 메타데이터를 컴파일 시간에 만든 완전 해시로 찾는다.
+// CommandHandler::handle 의 분기와 연결 계층(UPLOAD/GET_IMAGE/PROTO/SUBSCRIBE_EVENTS 처리,
+// 파이프라인 동시 실행 판단)이 같은 표를 쓴다.
+
+enum class CommandId : uint8_t {
+    Register,
+    Login,
+    ResetPassword,
+    GetHistory,
+    AddHistory,
+    AddHistoryBatch,
+    GetHistoryByEventType,
+    GetHistoryByDateRange,
+    GetHistoryByEventTypeAndDateRange,
+    GetHistoryPage,
+    GetHistoryByEventTypePage,
+    GetHistoryByDateRangePage,
+    GetHistoryByEventTypeAndDateRangePage,
+    GetHistorySince,
+    GetStats,
+    ChangeFrame,
+    GetFrame,
+    GetLog,
+    GetMetrics,
+    // 연결 계층이 직접 처리 (CommandHandler::handle 로 오면 에러)
+    Upload,
+    GetImage,
+    Proto,
+    SubscribeEvents,
+    Unknown
+};
+
+struct CommandInfo {
+    std::string_view name;
+    CommandId        id;
+    bool             readOnly;    // 상태를 바꾸지 않음: 파이프라인에서 다른 조회와 동시 실행
+    bool             needsAuth;   // 첫 인자가 등록된 사용자 이메일이어야 함 (CommandHandler::handle 이 분기 전에 확인)
+    bool             connection;  // 연결 계층 명령 (연결 상태나 프레이밍을 바꾼다)
+    uint16_t         maxPayload;  // 명령 이름 뒤 인자의 최대 바이트 수 (ADD_HISTORY_BATCH 는 여러 줄 전체)
+};
+
+// CommandId 순서대로 (kCommands[id] 로 바로 찾을 수 있게)
+inline constexpr CommandInfo kCommands[] = {
+    {"REGISTER",                                 CommandId::Register,                          false, false, false, 512},
+    {"LOGIN",                                    CommandId::Login,                             false, false, false, 512},
+    {"RESET_PASSWORD",                           CommandId::ResetPassword,                     false, false, false, 512},
+    {"GET_HISTORY",                              CommandId::GetHistory,                        true,  true,  false, 512},
+    {"ADD_HISTORY",                              CommandId::AddHistory,                        false, false, false, 2048},
+    {"ADD_HISTORY_BATCH",                        CommandId::AddHistoryBatch,                   false, false, false, 65000},
+    {"GET_HISTORY_BY_EVENT_TYPE",                CommandId::GetHistoryByEventType,             true,  true,  false, 512},
+    {"GET_HISTORY_BY_DATE_RANGE",                CommandId::GetHistoryByDateRange,             true,  true,  false, 512},
+    {"GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE", CommandId::GetHistoryByEventTypeAndDateRange, true,  true,  false, 512},
+    {"GET_HISTORY_PAGE",                         CommandId::GetHistoryPage,                    true,  true,  false, 512},
+    {"GET_HISTORY_BY_EVENT_TYPE_PAGE",           CommandId::GetHistoryByEventTypePage,         true,  true,  false, 512},
+    {"GET_HISTORY_BY_DATE_RANGE_PAGE",           CommandId::GetHistoryByDateRangePage,         true,  true,  false, 512},
+    {"GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE_PAGE", CommandId::GetHistoryByEventTypeAndDateRangePage, true, true, false, 512},
+    {"GET_HISTORY_SINCE",                        CommandId::GetHistorySince,                   true,  false, false, 64},
+    {"GET_STATS",                                CommandId::GetStats,                          true,  true,  false, 512},
+    {"CHANGE_FRAME",                             CommandId::ChangeFrame,                       false, false, false, 64},
+    {"GET_FRAME",                                CommandId::GetFrame,                          true,  false, false, 64},
+    {"GET_LOG",                                  CommandId::GetLog,                            true,  false, false, 64},
+    {"GET_METRICS",                              CommandId::GetMetrics,                        true,  false, false, 64},
+    {"UPLOAD",                                   CommandId::Upload,                            false, false, true,  1024},
+    {"GET_IMAGE",                                CommandId::GetImage,                          false, false, true,  1024},
+    {"PROTO",                                    CommandId::Proto,                             false, false, true,  64},
+    {"SUBSCRIBE_EVENTS",                         CommandId::SubscribeEvents,                   false, false, true,  64},
+};
+
+inline constexpr size_t kCommandCount = sizeof(kCommands) / sizeof(kCommands[0]);
+
+namespace command_table_detail {
+
+constexpr bool idsInOrder() {
+    for (size_t i = 0; i < kCommandCount; ++i) {
+        if (static_cast<size_t>(kCommands[i].id) != i) return false;
+    }
+    return kCommandCount == static_cast<size_t>(CommandId::Unknown);
+}
+static_assert(idsInOrder(), "kCommands must list every CommandId in declaration order");
+
+// 한도보다 한 바이트 긴 인자도 명령 줄("이름 인자\r\n", 바이너리 프레임은 같은 크기 제한)에 들어가야
+// 413 으로 거절된다. 넘으면 ReadBuffer 단계에서 줄이 너무 길다며 연결을 끊는다
+constexpr bool payloadsFitLine() {
+    for (const CommandInfo& info : kCommands) {
+        if (info.name.size() + 1 + info.maxPayload + 1 + 2 > ReadBuffer::kMaxLineLength) return false;
+    }
+    return true;
+}
+static_assert(payloadsFitLine(), "maxPayload + 1 must fit in ReadBuffer::kMaxLineLength with the command name");
+
+// 시드를 섞은 FNV-1a
+constexpr uint32_t hash(std::string_view s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+inline constexpr unsigned kSlotBits = 6;
+inline constexpr size_t kSlots = size_t{1} << kSlotBits;  // 명령 수보다 넉넉히
+static_assert(kCommandCount < kSlots);
+
+// 칸 번호는 상위 비트로: FNV-1a 의 하위 비트는 시드의 하위 비트에만 좌우돼
+// 마스크로 자르면 시드를 바꿔도 배치가 kSlots 가지뿐이다
+constexpr size_t slotOf(std::string_view s, uint32_t seed) {
+    return hash(s, seed) >> (32 - kSlotBits);
+}
+
+// 모든 이름이 서로 다른 칸에 들어가는 첫 시드
+constexpr uint32_t findSeed() {
+    for (uint32_t seed = 0; seed < 100000; ++seed) {
+        bool used[kSlots] = {};
+        bool ok = true;
+        for (size_t i = 0; i < kCommandCount && ok; ++i) {
+            size_t slot = slotOf(kCommands[i].name, seed);
+            ok = !used[slot];
+            used[slot] = true;
+        }
+        if (ok) return seed;
+    }
+    return UINT32_MAX;
+}
+
+inline constexpr uint32_t kSeed = findSeed();
+static_assert(kSeed != UINT32_MAX, "no collision-free seed for the command table");
+
+// 칸 → kCommands 인덱스 + 1 (0 은 빈 칸)
+constexpr std::array<uint8_t, kSlots> buildSlots() {
+    std::array<uint8_t, kSlots> slots{};
+    for (size_t i = 0; i < kCommandCount; ++i) {
+        slots[slotOf(kCommands[i].name, kSeed)] = static_cast<uint8_t>(i + 1);
+    }
+    return slots;
+}
+
+inline constexpr std::array<uint8_t, kSlots> kSlotTable = buildSlots();
+
+} // namespace command_table_detail
+
+// 이름이 정확히 일치하는 명령. 없으면 nullptr (해시 한 번 + 문자열 비교 한 번)
+constexpr const CommandInfo* lookupCommand(std::string_view name) {
+    using namespace command_table_detail;
+    uint8_t entry = kSlotTable[slotOf(name, kSeed)];
+    if (entry == 0 || kCommands[entry - 1].name != name) return nullptr;
+    return &kCommands[entry - 1];
+}
+
+static_assert(lookupCommand("GET_HISTORY_SINCE")->id == CommandId::GetHistorySince);
+static_assert(lookupCommand("GET_HISTORYX") == nullptr);
+
+// 명령 줄의 첫 토큰(앞 공백 무시, 공백·개행에서 끝)으로 찾는다
+constexpr const CommandInfo* findCommand(std::string_view line) {
+    size_t start = line.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) return nullptr;
+    size_t end = line.find_first_of(" \t\r\n", start);
+    return lookupCommand(line.substr(start, end == std::string_view::npos ? end : end - start));
+}
+
+constexpr CommandId commandId(std::string_view line) {
+    const CommandInfo* info = findCommand(line);
+    return info ? info->id : CommandId::Unknown;
+}
+
+#endif // COMMAND_TABLE_HPP
@@ -0,0 +1,64 @@
+#ifndef CONNECTION_WATCHDOG_HPP
+#define CONNECTION_WATCHDOG_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "server/TimerWheel.hpp"
+
+// 연결이 지금 기다리고 있는 것 (종류별로 제한 시간이 다르다)
+enum class TimeoutKind {
+    None,
+    Handshake,  // TLS 핸드쉐이크 완료
+    Idle,       // 다음 명령 (또는 응답 송신 진행)
+    Header,     // 받기 시작한 명령 줄의 끝 (바이트가 와도 연장하지 않음)
+    Upload      // UPLOAD 본문의 다음 바이트
+};
+
+// 타이머 휠 tick. 제한 시간은 초 단위라 이 정도 오차는 무방하다
+constexpr std::chrono::milliseconds kTimerTick{100};
+constexpr size_t                    kTimerSlots = 512;
+
+const char* timeoutName(TimeoutKind kind);
+// 종류별 만료 지표 증가
+void countTimeout(TimeoutKind kind);
+// 소켓에 아직 읽지 않은 바이트가 있는지 (드레인 중 막 도착한 요청은 받아 준다)
+bool bytesPending(int fd);
+
+// 스레드 모드용: 블로킹 SSL_read 중인 연결을 별도 스레드에서 감시하다가
+// 제한 시간이 지나면 shutdown(fd) 으로 읽기를 깨워 연결 스레드가 스스로 정리하게 한다
+class ConnectionWatchdog {
+public:
+    ConnectionWatchdog();
+    ~ConnectionWatchdog();
+
+    ConnectionWatchdog(const ConnectionWatchdog&) = delete;
+    ConnectionWatchdog& operator=(const ConnectionWatchdog&) = delete;
+
+    // fd 의 제한 시간 설정 (timeoutMs <= 0 이면 해제).
+    // betweenRequests: 처리 중인 요청 없이 다음 명령을 기다리는 중 (드레인 시 바로 닫아도 됨)
+    void arm(int fd, TimeoutKind kind, int timeoutMs, bool betweenRequests = false);
+    // close(fd) 전에 반드시 호출 (재사용된 fd 를 shutdown 하지 않도록)
+    void disarm(int fd);
+
+    // 리스너 인계 후: 명령을 기다리는 연결을 지금 닫고, 이후 기다리기 시작하는 연결도 닫는다
+    void drain();
+
+private:
+    void run();
+
+    std::mutex              mtx;
+    std::condition_variable cv;
+    bool                    stopping;
+    TimerWheel              wheel;
+    std::unordered_map<int, TimeoutKind> watched;
+    std::unordered_set<int> betweenRequests;
+    bool                    draining = false;
+    std::thread             thread;
+};
+
+#endif // CONNECTION_WATCHDOG_HPP
@@ -0,0 +1,141 @@
+#ifndef CORO_LOOP_HPP
+#define CORO_LOOP_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <openssl/ssl.h>
+
+#include "server/Async.hpp"
+#include "server/ConnectionWatchdog.hpp"
+#include "server/ReadBuffer.hpp"
+#include "server/TimerWheel.hpp"
+
+class TcpServer;
+class CoroLoop;
+
+// 코루틴 모드의 연결 하나. serve() 코루틴 프레임 안에 살고, 루프는 id 로 찾아 깨운다.
+// 명령을 기다리는 동안에는 수신 버퍼와 SSL 버퍼를 모두 놓아 연결당 비용이 코루틴 프레임 몇 개뿐이다.
+struct CoroConn {
+    uint64_t id  = 0;
+    int      fd  = -1;
+    SSL*     ssl = nullptr;
+
+    ReadBuffer  in{0};
+    std::string out;                       // 아직 보내지 않은 응답 (꽉 찬 레코드 단위로 송신)
+
+    std::coroutine_handle<> waiter;        // 소켓 이벤트를 기다리는 코루틴
+    uint32_t    events     = 0;            // 현재 epoll 에 등록된 이벤트
+    bool        handshaken = false;
+    bool        timedOut   = false;        // 제한 시간 초과: 이후 모든 I/O 실패
+    bool        closing    = false;        // 드레인으로 종료: 이후 모든 I/O 실패
+    bool        betweenRequests = false;   // 처리 중인 요청 없이 다음 명령을 기다리는 중
+    bool        served     = false;        // 명령을 하나 이상 받음 (드레인 시 첫 요청은 받아 준다)
+    TimeoutKind timeout    = TimeoutKind::None;
+};
+
+// epoll 루프 하나가 여러 연결 코루틴을 실행한다. 연결 흐름은 스레드 모드와 같은
+// 순차 코드(readLine → 실행 → writeAll)로 쓰되, 블로킹 대신 co_await 로 양보한다.
+class CoroLoop {
+public:
+    CoroLoop(TcpServer* server, int index);
+    ~CoroLoop();
+
+    // 루프 스레드 본체 (반환하지 않음)
+    void run();
+
+    // 리스닝 소켓 등록. shared 면 여러 루프가 같은 소켓을 EPOLLEXCLUSIVE 로 나눠 accept
+    void addListener(int listen_fd, bool shared);
+
+    // 루프 스레드에서 실행할 작업 예약 (스레드 안전)
+    void post(std::function<void()> fn);
+
+    // 리스너 인계 후 (루프 스레드에서): accept 를 멈추고 다음 명령을 기다리는 연결을 닫는다
+    void drain();
+
+private:
+    static constexpr uint64_t kListenerId = 0;
+    static constexpr uint64_t kWakeupId   = 1;
+
+    // 소켓 이벤트 대기. 제한 시간이 지났거나 드레인으로 닫는 중이면 false
+    struct IoAwaiter {
+        CoroLoop* loop;
+        CoroConn& conn;
+        uint32_t  events;
+
+        bool await_ready() const noexcept { return conn.timedOut || conn.closing; }
+        void await_suspend(std::coroutine_handle<> h);
+        bool await_resume() const noexcept { return !conn.timedOut && !conn.closing; }
+    };
+
+    // 명령들을 작업 풀에서 동시에 실행하고 모두 끝나면 루프 스레드에서 재개
+    class PoolAwaiter {
+    public:
+        PoolAwaiter(CoroLoop* loop, const std::vector<std::string>& cmds,
+                    std::vector<std::string>& results);
+        bool await_ready() const noexcept { return cmds.empty(); }
+        bool await_suspend(std::coroutine_handle<> h);
+        void await_resume() const noexcept {}
+
+    private:
+        void finishOne(std::coroutine_handle<> h);
+
+        CoroLoop*                       loop;
+        const std::vector<std::string>& cmds;
+        std::vector<std::string>&       results;
+        std::atomic<size_t>             remaining;
+    };
+
+    void acceptAll();
+    void runPosted();
+    void expireTimers();
+    void setInterest(CoroConn& conn, uint32_t events);
+    void arm(CoroConn& conn, TimeoutKind kind, int timeoutMs);
+    void closeConnection(CoroConn& conn);
+
+    IoAwaiter waitIo(CoroConn& conn, uint32_t events) { return IoAwaiter{this, conn, events}; }
+
+    // 연결 코루틴
+    Detached    serve(int client_fd);
+    Async<bool> handshake(CoroConn& conn);
+    Async<bool> serveText(CoroConn& conn);
+    Async<bool> serveBinary(CoroConn& conn);
+    // SUBSCRIBE_EVENTS 이후 이벤트 줄만 보낸다. 항상 false (연결 종료)
+    Async<bool> serveEvents(CoroConn& conn, int eventType);
+
+    // 전송 계층
+    Async<bool> readSome(CoroConn& conn);
+    Async<bool> readLine(CoroConn& conn, std::string& line);
+    Async<bool> readExact(CoroConn& conn, size_t n);
+    Async<bool> writeAll(CoroConn& conn, std::string_view data);
+    // 응답을 out 에 붙이고 꽉 찬 레코드 분량만 보낸다. 나머지는 다음 읽기 전에 flushOutput
+    Async<bool> respond(CoroConn& conn, std::string_view resp);
+    Async<bool> flushOutput(CoroConn& conn);
+    // prefix(남은 응답 + 길이 헤더)는 본문 첫 조각 앞에 붙여 보낸다
+    Async<bool> sendImage(CoroConn& conn, int fd, size_t fileSize, std::string prefix);
+    // 본문 filesize 바이트를 받아 저장. 거절돼도 drain 이면 본문을 읽고 버린다
+    Async<bool> receiveUpload(CoroConn& conn, const std::string& filename, size_t filesize,
+                              bool drain, std::string& result);
+
+    TcpServer* server;
+    int        index;
+    int        epfd;
+    int        wakeFd;
+    int        listenFd;
+    bool       draining;
+    uint64_t   nextId;
+
+    std::unordered_map<uint64_t, CoroConn*> conns;  // 연결 객체는 각 serve() 프레임 소유
+    TimerWheel timers;
+
+    std::mutex                         postMtx;
+    std::vector<std::function<void()>> posted;
+};
+
+#endif // CORO_LOOP_HPP
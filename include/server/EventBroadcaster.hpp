@@ -0,0 +1,73 @@
+#ifndef EVENT_BROADCASTER_HPP
+#define EVENT_BROADCASTER_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 구독 응답과 밀린 구독자를 끊을 때 보내는 마지막 줄
+inline constexpr const char* kSubscribedResponse =
+    R"({"status": "success", "code": 200, "message": "Subscribed"})";
+inline constexpr const char* kSubscriberTooSlowResponse =
+    R"({"status": "error", "code": 503, "message": "Subscriber too slow"})";
+
+using EventLine = std::shared_ptr<const std::string>;  // 모든 구독자가 같은 직렬화 결과를 공유
+
+// SUBSCRIBE_EVENTS 연결 하나의 대기열. 발행 스레드가 넣고 연결 스레드(루프)가 꺼낸다
+class EventSubscription {
+public:
+    static constexpr size_t kQueueLimit = 256;  // 넘치면 구독자를 끊는다
+
+    EventSubscription(int eventType, std::function<void()> wake);
+
+    // 최대 max 개를 꺼내 out 뒤에 붙인다. 밀려서 끊긴 구독이면 false (이후 연결 종료)
+    bool take(std::vector<EventLine>& out, size_t max = kQueueLimit);
+
+private:
+    friend class EventBroadcaster;
+
+    // 대기열이 비어 있다가 채워지면 wake 호출. 넘치면 끊고 true (목록에서 제거)
+    bool push(const EventLine& line);
+    // 연결이 끝남: 이후 wake 를 부르지 않는다
+    void cancel();
+
+    const int             eventType;  // -1: 전체
+    std::mutex            mtx;
+    std::deque<EventLine> queue;
+    std::function<void()> wake;       // 루프/스레드를 깨운다 (mtx 안에서 호출)
+    bool                  overflowed = false;
+};
+
+// 새 히스토리 레코드를 구독자들에게 나눠 준다 (프로세스 전역)
+class EventBroadcaster {
+public:
+    static EventBroadcaster& instance();
+
+    // wake 는 대기열에 첫 이벤트가 들어오거나 구독이 끊길 때 발행 스레드에서 불린다
+    std::shared_ptr<EventSubscription> subscribe(int eventType, std::function<void()> wake);
+    void unsubscribe(const std::shared_ptr<EventSubscription>& sub);
+
+    // 구독자가 없으면 직렬화를 건너뛰도록
+    bool hasSubscribers() const;
+    void publish(int eventType, std::string line);
+
+private:
+    mutable std::mutex                              mtx;
+    std::vector<std::shared_ptr<EventSubscription>> subs;
+};
+
+// "SUBSCRIBE_EVENTS [eventType]" 파싱. 형식이 틀리면 false
+bool parseSubscribe(std::string_view cmd, int& eventType);
+
+// 블로킹 소켓 연결(스레드 모드, 로컬 소켓)을 구독 스트림으로 돌린다. 구독 응답부터 보내고,
+// 연결이 끊기거나 밀려서 끊길 때까지 이벤트 줄을 보낸다. readInput 은 fd 가 읽을 수 있을 때
+// 들어온 바이트를 읽고 버린다 (닫혔으면 false)
+void streamEvents(int fd, int eventType, const std::function<bool(std::string_view)>& send,
+                  const std::function<bool()>& readInput);
+
+#endif // EVENT_BROADCASTER_HPP
@@ -0,0 +1,158 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <openssl/ssl.h>
+
+#include "server/ConnectionWatchdog.hpp"
+#include "server/ImageHandler.hpp"
+#include "server/ReadBuffer.hpp"
+#include "server/TimerWheel.hpp"
+
+class TcpServer;
+class EventSubscription;
+
+// 리액터 모드에서 연결 하나의 상태
+enum class ConnState {
+    Handshake,     // 논블로킹 SSL_accept 진행 중
+    Reading,       // 명령 줄 수신 대기
+    Uploading,     // UPLOAD 본문 수신 중
+    SendingImage,  // GET_IMAGE 본문 송신 중
+    Subscribed     // SUBSCRIBE_EVENTS 이후 이벤트 줄만 송신 (입력은 버림)
+};
+
+// 파이프라인으로 실행 중인 명령의 응답 자리 (요청 순서대로 송신)
+struct ResponseSlot {
+    bool        ready = false;
+    std::string body;
+    uint16_t    opcode    = 0;  // 바이너리 모드 응답 프레임용
+    uint32_t    requestId = 0;
+};
+
+struct Connection {
+    uint64_t  id    = 0;
+    int       fd    = -1;
+    SSL*      ssl   = nullptr;
+    ConnState state = ConnState::Handshake;
+
+    ReadBuffer  in;             // 아직 처리하지 않은 수신 바이트
+    std::string out;            // 송신 대기 바이트
+    size_t      outOffset = 0;  // out 중 이미 보낸 위치
+
+    std::deque<ResponseSlot> inflight;  // 작업 풀에 보낸 명령의 응답 (요청 순서)
+    uint64_t inflightBase = 0;          // inflight.front() 의 순번
+
+    bool     binary          = false;  // PROTO BINARY 협상 후 프레임 모드
+    uint32_t uploadRequestId = 0;      // 진행 중인 업로드 프레임의 requestId
+    size_t   discard         = 0;      // 거절한 업로드 프레임의 남은 본문 (읽고 버림)
+
+    UploadSession upload;
+    int    imageFd        = -1;     // GET_IMAGE 본문 파일
+    size_t imageOffset    = 0;      // 다음에 보낼 파일 위치
+    size_t imageSize      = 0;
+    bool   imageKtls      = false;  // SSL_sendfile 로 전송 (커널 TLS)
+
+    std::shared_ptr<EventSubscription> subscription;  // Subscribed 상태의 이벤트 대기열
+
+    TimeoutKind timeout     = TimeoutKind::None;  // 타이머 휠에 걸린 제한 시간 종류
+    size_t      timeoutMark = 0;                  // 업로드 타이머를 연장한 시점의 수신량
+
+    bool     readWantsWrite  = false;  // SSL_read 가 WANT_WRITE 반환 (재협상 등)
+    bool     writeWantsRead  = false;  // SSL_write 가 WANT_READ 반환
+    bool     closeAfterFlush = false;  // out 을 다 보내면 종료
+    bool     barrier         = false;  // 상태를 바꾸는 명령 실행 중 (끝날 때까지 다음 줄 보류)
+    bool     served          = false;  // 명령을 하나 이상 받음 (드레인 시 첫 요청은 받아 준다)
+    uint32_t events          = 0;      // 현재 epoll 에 등록된 이벤트
+};
+
+// epoll 기반 이벤트 루프. 루프 스레드 하나가 여러 연결을 논블로킹으로 처리한다.
+class EventLoop {
+public:
+    EventLoop(TcpServer* server, int index);
+    ~EventLoop();
+
+    // 루프 스레드 본체 (반환하지 않음)
+    void run();
+
+    // accept 할 리스닝 소켓 등록 (run() 이전에 호출).
+    // ownsAccepted 면 accept 한 연결을 이 루프에서 직접 처리 (SO_REUSEPORT 샤딩),
+    // 아니면 TcpServer 가 모든 루프에 분배
+    void addListener(int listen_fd, bool ownsAccepted);
+
+    // 다른 스레드에서 accept 한 소켓을 이 루프로 넘긴다 (스레드 안전)
+    void adoptConnection(int client_fd);
+
+    // 루프 스레드에서 실행할 작업 예약 (스레드 안전)
+    void post(std::function<void()> fn);
+
+    // 리스너 인계 후 (루프 스레드에서): accept 를 멈추고, 처리 중인 요청이 없는 연결부터 닫는다
+    void drain();
+
+private:
+    static constexpr uint64_t kListenerId = 0;
+    static constexpr uint64_t kWakeupId   = 1;
+
+    void acceptAll();
+    void expireTimers();
+    void armTimer(Connection& conn);
+    int  nextTimeoutMs() const;
+    void addConnection(int client_fd);
+    void closeConnection(Connection& conn);
+    // 첫 명령 이후 요청/업로드/응답이 모두 끝나 다음 명령을 기다리는 중
+    bool betweenRequests(const Connection& conn) const;
+    void runPosted();
+
+    void onEvent(Connection& conn, uint32_t events);
+    void doHandshake(Connection& conn);
+    bool doRead(Connection& conn);
+    bool doWrite(Connection& conn);
+    bool process(Connection& conn);
+    bool canStart(const Connection& conn, const std::string& cmd) const;
+    void processLine(Connection& conn, const std::string& cmd);
+    int  processFrame(Connection& conn);
+    bool startUpload(Connection& conn, uint32_t requestId, const std::string& filename,
+                     size_t filesize);
+    void startImage(Connection& conn, uint32_t requestId, const std::string& imagePath);
+    void startCommand(Connection& conn, uint16_t opcode, uint32_t requestId,
+                      const std::string& cmd);
+    void appendResponse(Connection& conn, uint16_t opcode, uint32_t requestId,
+                        const std::string& resp);
+    void completeCommand(uint64_t id, uint64_t seq, std::string resp);
+    void deliver(Connection& conn, uint64_t seq, std::string resp);
+    bool readPaused(const Connection& conn) const;
+    bool writeDue(const Connection& conn) const;
+    bool fillImageChunk(Connection& conn);
+    int  sendImageKtls(Connection& conn);
+    void finishImage(Connection& conn);
+    void pumpEvents(Connection& conn);
+    void updateInterest(Connection& conn);
+    void setInterest(Connection& conn, uint32_t events);
+
+    TcpServer* server;
+    int        index;
+    int        epfd;
+    int        wakeFd;
+    int        listenFd;
+    bool       ownsAccepted;
+    bool       draining;
+    uint64_t   nextId;
+
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> conns;
+    std::vector<uint64_t> pendingReads;  // SSL 내부 버퍼에 데이터가 남은 연결
+
+    // 연결별 핸드쉐이크/유휴/헤더/업로드 제한 시간
+    TimerWheel timers;
+
+    std::mutex                         postMtx;
+    std::vector<std::function<void()>> posted;
+};
+
+#endif // EVENT_LOOP_HPP
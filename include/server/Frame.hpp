@@ -0,0 +1,48 @@
+#ifndef FRAME_HPP
+#define FRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 바이너리 프레이밍 모드 ("PROTO BINARY" 로 협상 후 양방향 적용).
+// 모든 메시지는 12바이트 고정 헤더 + payload, 정수는 모두 big-endian.
+//
+//   0      2      4          8          12
+//   +------+------+----------+----------+------------
+//   |opcode|flags | requestId|  length  | payload ...
+//   +------+------+----------+----------+------------
+//
+// 응답은 요청 opcode 에 kFrameResponse 비트를 더하고 requestId 를 그대로 돌려준다.
+
+// 요청 opcode
+constexpr uint16_t kFrameCommand  = 0x0001;  // payload: 텍스트 명령 (개행 없이)
+constexpr uint16_t kFrameUpload   = 0x0002;  // payload: [u16 파일명 길이][파일명][파일 바이트]
+constexpr uint16_t kFrameGetImage = 0x0003;  // payload: 이미지 경로
+
+constexpr uint16_t kFrameResponse = 0x8000;
+
+// flags
+constexpr uint16_t kFrameJson = 0x0001;  // payload 가 JSON (아니면 원시 바이트, 예: 이미지 본문)
+
+struct FrameHeader {
+    static constexpr size_t kSize = 12;
+
+    uint16_t opcode    = 0;
+    uint16_t flags     = 0;
+    uint32_t requestId = 0;
+    uint32_t length    = 0;  // payload 바이트 수
+
+    void encode(char* dst) const;
+    static FrameHeader decode(const char* src);
+};
+
+// 헤더 + payload 를 out 에 덧붙인다
+void appendFrame(std::string& out, uint16_t opcode, uint16_t flags, uint32_t requestId,
+                 const std::string& payload);
+
+// 요청에 대한 JSON 응답 프레임 (끝의 개행은 떼어 낸다)
+void appendJsonResponse(std::string& out, uint16_t requestOpcode, uint32_t requestId,
+                        const std::string& json);
+
+#endif // FRAME_HPP
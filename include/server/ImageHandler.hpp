@@ -6,17 +6,75 @@
 
 #include <openssl/ssl.h>
 #include <string>
+#include <string_view>
+#include <functional>
 #include <sqlite3.h>
 
+class ReadBuffer;
+
+// 진행 중인 업로드 상태 (블로킹/논블로킹 경로 공용)
+struct UploadSession {
+    std::string filename;
+    std::string fullPath;   // "images/<filename>"
+    size_t      filesize = 0;
+    size_t      received = 0;
+    int         fd       = -1;
+    bool        failed   = false;  // 쓰기 실패 (finishUpload 에서 500)
+
+    UploadSession() = default;
+    UploadSession(UploadSession&& other) noexcept;
+    UploadSession& operator=(UploadSession&& other) noexcept;
+    ~UploadSession();
+
+    // 본문 조각을 파일 끝에 이어 쓴다
+    void write(const char* data, size_t len);
+};
+
 class ImageHandler {
 public:
+    // kTLS 를 쓸 수 없을 때 GET_IMAGE 본문을 읽어 SSL_write 하는 단위
+    static constexpr size_t kImageChunk = 64 * 1024;
+
     explicit ImageHandler(sqlite3* db);
 
-    std::string handleImageUpload(SSL* ssl, const std::string& filename, size_t filesize);
-    void handleGetImage(SSL* ssl, const std::string& imagePath);
+    // 블로킹 경로의 이미지 파일 I/O 를 io_uring 으로 (커널이 지원할 때만). 실제 사용 여부 반환
+    bool setIoUring(bool enabled);
+
+    // buffered: 명령 줄과 함께 이미 읽혀 버퍼에 남은 본문 바이트 (있으면 먼저 소비)
+    // onProgress: 본문을 읽을 때마다 누적 수신량으로 호출 (진행 제한 시간 연장용)
+    std::string handleImageUpload(SSL* ssl, const std::string& filename, size_t filesize,
+                                  ReadBuffer* buffered = nullptr,
+                                  const std::function<void(size_t)>& onProgress = nullptr);
+    // prefix: 아직 보내지 않은 앞선 응답 바이트 (길이 헤더, 본문과 같은 레코드로 보낸다)
+    void handleGetImage(SSL* ssl, const std::string& imagePath, std::string prefix = {});
+
+    // 업로드 검증 후 파일을 연다. 실패 시 에러 JSON, 성공 시 빈 문자열
+    std::string beginUpload(const std::string& filename, size_t filesize, UploadSession& session);
+    // 수신 완료된 업로드를 닫고 결과 JSON 반환
+    std::string finishUpload(UploadSession& session);
+    // 중단된 업로드의 임시 파일 제거
+    void abortUpload(UploadSession& session);
+
+    // 이미지 파일을 연다. 성공 시 fd 와 크기, 일반 파일이 아니거나 실패 시 -1
+    static int openImage(const std::string& imagePath, size_t& fileSize);
+    // 이 연결의 송신이 커널 TLS 로 오프로드되어 SSL_sendfile 을 쓸 수 있는지
+    static bool ktlsSendEnabled(SSL* ssl);
+    // 블로킹 소켓에서 openImage 로 연 파일 본문 전송. 길이 헤더는 호출자가 prefix 로 넘기면
+    // 본문 첫 조각 앞에 붙여 한 번에 보낸다
+    bool sendImage(SSL* ssl, int fd, size_t fileSize, const std::string& prefix = {});
 
 private:
+    // 블로킹 소켓에서 본문 전송: kTLS 면 SSL_sendfile, 아니면 큰 버퍼로 read + SSL_write
+    bool sendFileKtls(SSL* ssl, int fd, size_t fileSize);
+    bool sendFileBuffered(SSL* ssl, int fd, size_t fileSize, std::string_view head);
+    // io_uring: 다음 조각을 등록 버퍼로 미리 읽으면서 현재 조각을 SSL_write
+    bool sendFileUring(SSL* ssl, int fd, size_t fileSize, std::string_view head);
+    // io_uring: 한 버퍼를 파일에 쓰는 동안 다른 버퍼로 SSL_read
+    bool receiveUring(SSL* ssl, UploadSession& session,
+                      const std::function<void(size_t)>& onProgress);
+
     sqlite3* db;
+    bool     useUring = false;
 };
 
 #endif // IMAGE_HANDLER_HPP
@@ -0,0 +1,59 @@
+#ifndef IO_URING_HPP
+#define IO_URING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/uio.h>
+
+// io_uring 최소 래퍼 (liburing 없이 시스템 콜 직접 사용).
+// 등록 버퍼 대상 파일 읽기/쓰기만 지원. 한 스레드에서만 사용 (스레드 안전하지 않음).
+class IoUring {
+public:
+    // 커널이 io_uring 을 지원하고 허용하는지 (처음 한 번 검사 후 캐시)
+    static bool supported();
+
+    explicit IoUring(unsigned entries);
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool valid() const { return ringFd >= 0; }
+
+    // 고정 버퍼 등록 (READ_FIXED/WRITE_FIXED 의 bufIndex 대상)
+    bool registerBuffers(const iovec* iovs, unsigned count);
+
+    // 제출 큐에 요청 추가. 큐가 가득 찼으면 false
+    bool prepReadFixed(int fd, void* buf, unsigned len, uint64_t offset, int bufIndex, uint64_t userData);
+    bool prepWriteFixed(int fd, const void* buf, unsigned len, uint64_t offset, int bufIndex, uint64_t userData);
+
+    // 추가한 요청을 제출하고 완료가 waitFor 개 이상 쌓일 때까지 대기 (io_uring_enter 한 번)
+    bool submitAndWait(unsigned waitFor);
+
+    // 완료 하나 꺼내기. 없으면 false. res 는 read/write 반환값 또는 -errno
+    bool popCompletion(uint64_t& userData, int& res);
+
+private:
+    struct io_uring_sqe* nextSqe();
+
+    int      ringFd;
+    void*    sqRing;
+    void*    cqRing;
+    size_t   sqRingSize;
+    size_t   cqRingSize;
+    struct io_uring_sqe* sqes;
+    size_t   sqesSize;
+
+    unsigned* sqHead;
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    struct io_uring_cqe* cqes;
+
+    unsigned pending;  // 추가했지만 아직 제출하지 않은 요청 수
+};
+
+#endif // IO_URING_HPP
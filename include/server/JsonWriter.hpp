@@ -0,0 +1,53 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// 출력 문자열 끝에 JSON 을 바로 써 나가는 직렬화기 (트리를 만들지 않음).
+// 결과는 nlohmann::json::dump() 와 바이트 단위로 같다: 공백 없음, 같은 문자열 이스케이프,
+// 같은 실수 표기 (Grisu2, 정수 값은 "61.0"). 객체 키 순서는 호출 순서 그대로이므로
+// dump() 와 맞추려면 호출자가 키를 사전 순으로 써야 한다.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out(out) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    // 객체 안에서 다음 키 (쉼표 포함)
+    void key(std::string_view name);
+
+    // 값. 잘못된 UTF-8 문자열은 쓰지 않고 ok() 를 false 로 (dump() 는 예외를 던진다)
+    void value(std::string_view s);
+    void value(const char* s) { value(std::string_view(s)); }
+    void value(int64_t n);
+    void value(int n) { value(static_cast<int64_t>(n)); }
+    void value(double x);  // 유한하지 않으면 null
+    void value(bool b);
+    void null();
+    // 이미 직렬화된 JSON 값을 그대로
+    void raw(std::string_view json);
+
+    // 지금까지 쓴 내용이 올바른 JSON 인지 (잘못된 UTF-8 을 만나지 않았는지)
+    bool ok() const { return valid; }
+
+private:
+    // 배열 원소나 객체 멤버 앞의 쉼표
+    void separate();
+    void escape(std::string_view s);
+
+    static constexpr size_t kMaxDepth = 16;
+
+    std::string& out;
+    bool first[kMaxDepth] = {};  // 깊이별로 아직 원소를 쓰지 않았는지
+    size_t depth = 0;
+    bool afterKey = false;
+    bool valid = true;
+};
+
+#endif // JSON_WRITER_HPP
@@ -0,0 +1,25 @@
+#ifndef LISTENER_HANDOFF_HPP
+#define LISTENER_HANDOFF_HPP
+
+#include <string>
+#include <vector>
+
+// 무중단 재시작용 리스닝 소켓 인계.
+// 실행 중인 서버는 Unix 소켓에서 인계 요청을 기다리고, 새 서버는 시작할 때 그 소켓에
+// 접속해 SCM_RIGHTS 로 리스닝 fd 를 받는다. 포트를 다시 bind 하지 않으므로
+// 인계 중에 도착한 연결도 커널 accept 큐에 그대로 남아 새 서버가 받는다.
+class ListenerHandoff {
+public:
+    // 새 서버: path 의 기존 서버에게서 리스닝 fd 를 받는다.
+    // 기존 서버가 없거나 실패하면 빈 벡터. 반환 시점에 기존 서버는 path 를 이미 정리했다
+    static std::vector<int> receive(const std::string& path);
+
+    // 기존 서버: path 에 인계 요청용 소켓을 연다. 실패 시 -1
+    static int listen(const std::string& path);
+
+    // 기존 서버: 요청 하나를 받아 fds 를 보내고 path 를 정리한다 (블로킹).
+    // 보냈으면 true, 이후 호출자는 accept 를 멈추고 연결을 비워야 한다
+    static bool serve(int handoffFd, const std::string& path, const std::vector<int>& fds);
+};
+
+#endif // LISTENER_HANDOFF_HPP
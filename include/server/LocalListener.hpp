@@ -0,0 +1,46 @@
+#ifndef LOCAL_LISTENER_HPP
+#define LOCAL_LISTENER_HPP
+
+#include <sys/types.h>
+#include <atomic>
+#include <string>
+
+class TcpServer;
+class ReadBuffer;
+
+// 같은 기기의 생산자(검출 프로세스)용 평문 Unix 소켓 리스너.
+// TLS 대신 소켓 파일 권한과 SO_PEERCRED 로 접속자를 제한하고, TCP 와 같은 텍스트 명령 프로토콜을
+// 연결당 스레드로 처리한다. 명령 실행은 같은 작업 풀, 제한 시간은 같은 감시 스레드를 쓴다.
+class LocalListener {
+public:
+    explicit LocalListener(TcpServer* server);
+    ~LocalListener();
+
+    LocalListener(const LocalListener&) = delete;
+    LocalListener& operator=(const LocalListener&) = delete;
+
+    // path 에 소켓을 만들고 권한을 mode 로 맞춘다. 남아 있던 소켓 파일은 지운다 (인계 시 새 서버가 가져감)
+    bool open(const std::string& path, int mode);
+    // accept 스레드 시작
+    void start();
+    // 리스너 인계 후: accept 중단 (연결은 감시 스레드의 드레인이 정리)
+    void drain();
+
+    // 접속한 프로세스의 uid 가 root, 서버와 같은 uid, allowUid 중 하나인지
+    static bool peerAllowed(int fd, int allowUid, pid_t& pid, uid_t& uid);
+
+private:
+    void acceptLoop();
+    // 연결 하나의 명령 루프 (블로킹 소켓)
+    void serve(int fd);
+    // 업로드 본문을 rbuf 에 남은 바이트부터 받아 파일로. 결과 JSON 반환, 연결이 끊기면 빈 문자열
+    std::string receiveUpload(int fd, ReadBuffer& rbuf, const std::string& filename, size_t filesize);
+    // GET_IMAGE: 8바이트 길이 헤더 + 본문 (sendfile). pending 은 앞서 모아 둔 응답
+    void sendImage(int fd, const std::string& imagePath, std::string& pending);
+
+    TcpServer*        server;
+    int               listenFd = -1;
+    std::atomic<bool> draining{false};
+};
+
+#endif // LOCAL_LISTENER_HPP
@@ -0,0 +1,47 @@
+#ifndef READ_BUFFER_HPP
+#define READ_BUFFER_HPP
+
+#include <cstddef>
+#include <vector>
+
+// 연결별 수신 버퍼. SSL_read 를 레코드 단위로 크게 받아 두고
+// 명령 줄('\n' 종료)을 memchr 로 잘라낸다. 줄 뒤에 이미 들어온
+// 바이트(UPLOAD 본문 등)는 버퍼에 남아 다음 소비자가 가져간다.
+class ReadBuffer {
+public:
+    static constexpr size_t kDefaultCapacity = 16 * 1024;  // TLS 레코드 최대 크기
+    static constexpr size_t kMaxLineLength   = 64 * 1024;  // 개행 없이 이보다 길면 비정상
+
+    // capacity 0 이면 첫 prepareWrite() 때 할당
+    explicit ReadBuffer(size_t capacity = kDefaultCapacity);
+
+    const char* data() const { return buf.data() + rpos; }
+    size_t      size() const { return wpos - rpos; }
+    bool        empty() const { return rpos == wpos; }
+
+    // 완성된 줄이 있으면 '\n' 포함 길이, 없으면 0. 이미 훑은 구간은 다시 보지 않는다
+    size_t findLine();
+
+    // 앞에서 n 바이트 소비
+    void consume(size_t n);
+
+    // 최대 n 바이트를 dst 로 복사하고 소비. 복사한 바이트 수 반환
+    size_t take(char* dst, size_t n);
+
+    // 최소 minSpace 바이트의 쓰기 공간을 확보하고 쓰기 위치 반환
+    char*  prepareWrite(size_t minSpace = kDefaultCapacity);
+    size_t writable() const { return buf.size() - wpos; }
+    // prepareWrite() 위치에 n 바이트를 채웠음을 반영
+    void   commit(size_t n) { wpos += n; }
+
+    // 비어 있으면 저장 공간 반납 (유휴 연결 메모리 절약)
+    void release();
+
+private:
+    std::vector<char> buf;
+    size_t rpos;     // 읽기 시작 위치
+    size_t wpos;     // 쓰기 시작 위치
+    size_t scanned;  // rpos 부터 '\n' 이 없음을 확인한 길이
+};
+
+#endif // READ_BUFFER_HPP
@@ -0,0 +1,46 @@
+#ifndef RECORD_WRITER_HPP
+#define RECORD_WRITER_HPP
+
+#include <openssl/ssl.h>
+#include <cstddef>
+#include <string>
+
+#include "server/ServerMetrics.hpp"
+
+// TLS 레코드 하나에 담기는 최대 평문 크기. SSL_write 는 이 단위로 레코드를 나눈다
+inline constexpr size_t kTlsRecordSize = 16 * 1024;
+
+// SSL_write(또는 SSL_sendfile) 한 번으로 bytes 를 보냈을 때 만들어진 레코드 수를 지표에 반영
+inline void countTlsRecords(size_t bytes) {
+    serverMetrics().tlsRecordsSent.fetch_add((bytes + kTlsRecordSize - 1) / kTlsRecordSize,
+                                             std::memory_order_relaxed);
+}
+
+// 블로킹 연결의 응답 송신 버퍼.
+// 응답마다 SSL_write 하면 작은 레코드가 응답 수만큼 생기므로, 모아 두었다가
+// 꽉 찬 레코드가 만들어질 만큼 쌓이면 그만큼 보내고 나머지는 배치 끝(flush)에 보낸다.
+class RecordWriter {
+public:
+    explicit RecordWriter(SSL* ssl) : ssl(ssl) {}
+
+    // 응답 하나를 붙인다. 꽉 찬 레코드 분량은 바로 송신. 송신 실패 시 false
+    bool append(const char* data, size_t len);
+    bool append(const std::string& resp) { return append(resp.data(), resp.size()); }
+
+    // 남은 바이트를 모두 보낸다. 다음 블로킹 읽기나 연결 종료 전에 호출
+    bool flush();
+
+    // 보내지 않은 바이트를 넘겨받는다 (이미지 본문 첫 조각 앞에 붙여 보낼 때)
+    std::string take();
+
+    bool failed() const { return error; }
+
+private:
+    bool send(size_t len);
+
+    SSL*        ssl;
+    std::string buf;
+    bool        error = false;
+};
+
+#endif // RECORD_WRITER_HPP
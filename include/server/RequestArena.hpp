@@ -0,0 +1,86 @@
+#ifndef REQUEST_ARENA_HPP
+#define REQUEST_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 요청 하나 동안만 쓰는 메모리 (명령 파싱, 조회 행, 응답 JSON).
+// 작업 스레드마다 하나씩 두고 요청이 끝나면 통째로 비운다. 개별 해제는 하지 않으며,
+// 초기 버퍼를 넘으면 힙에서 더 받아 (overflow) 요청이 끝날 때 함께 돌려준다.
+class RequestArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kInitialSize = 64 * 1024;
+
+    // 현재 스레드에서 진행 중인 요청의 아레나. 요청 밖이면 기본 힙 (new/delete)
+    static std::pmr::memory_resource* resource();
+
+    // p 가 이 스레드 아레나에서 받은 메모리인지 (초기 버퍼 또는 넘쳐서 힙에서 더 받은 블록)
+    static bool owns(const void* p);
+
+    // 요청 하나의 범위. 아레나에서 할당한 객체는 모두 이 범위 안에서 소멸해야 한다.
+    // 끝나면 사용량을 지표에 반영하고 아레나를 비운다
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    // 초기 버퍼를 넘은 할당을 세는 상위 자원
+    class Overflow : public std::pmr::memory_resource {
+    public:
+        size_t bytes = 0;
+        std::vector<std::pair<std::byte*, size_t>> blocks;  // 돌려주기 전인 블록 (요청당 몇 개)
+    private:
+        void* do_allocate(size_t bytes, size_t align) override;
+        void  do_deallocate(void* p, size_t bytes, size_t align) override;
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    RequestArena();
+    static RequestArena& local();
+
+    void* do_allocate(size_t bytes, size_t align) override;
+    void  do_deallocate(void*, size_t, size_t) override {}
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::unique_ptr<std::byte[]>        initial;
+    Overflow                            overflow;
+    std::pmr::monotonic_buffer_resource mono;
+    size_t                              used   = 0;
+    bool                                active = false;
+};
+
+// 현재 요청 아레나에서 할당하는 상태 없는 allocator (기본 생성이 필요한 컨테이너용).
+// nlohmann::json 은 해제할 때마다 allocator 를 새로 만들어 할당 때의 자원을 들고 다닐 수 없으므로,
+// 해제는 그때의 Scope 가 아니라 블록의 출처로 가른다 (요청 밖에서 만든 값을 요청 안에서 해제하거나 그 반대)
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(RequestArena::resource()->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        // 아레나 블록은 Scope 가 끝날 때 한꺼번에 돌려준다
+        if (RequestArena::owns(p)) return;
+        std::pmr::new_delete_resource()->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+};
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+#endif // REQUEST_ARENA_HPP
@@ -0,0 +1,53 @@
+#ifndef SERVER_CONFIG_HPP
+#define SERVER_CONFIG_HPP
+
+#include <string>
+
+#include "util/Logger.hpp"
+
+// 연결 처리 모델
+enum class IoMode {
+    Thread,   // 연결당 스레드 + 블로킹 SSL_read (기존 방식, fallback)
+    Reactor,  // 논블로킹 소켓 + epoll 이벤트 루프
+    Coro      // epoll 루프 위의 연결별 C++20 코루틴 (순차 코드, 유휴 연결 메모리 최소)
+};
+
+struct ServerConfig {
+    IoMode ioMode      = IoMode::Reactor;
+    int    loopThreads = 0;   // 이벤트/코루틴 루프 스레드 수 (0: 코어 수)
+
+    bool   reusePort   = false;  // 리액터/코루틴: 루프마다 SO_REUSEPORT 리스너를 따로 열어 accept 분산
+    int    backlog     = 128;    // listen() backlog
+    int    acceptBatch = 64;     // 이벤트 1회당 accept4 최대 횟수
+
+    int    handshakeTimeoutMs = 10000;   // TLS 핸드쉐이크 제한 시간
+    int    idleTimeoutMs      = 300000;  // 명령 사이 무응답 허용 시간 (0: 끔)
+    int    headerTimeoutMs    = 10000;   // 명령 줄 첫 바이트부터 줄 끝까지 (0: 끔)
+    int    uploadTimeoutMs    = 30000;   // 업로드 본문이 진행 없이 멈춰 있는 시간 (0: 끔)
+
+    int    sessionCacheSize  = 1024;   // 서버 TLS 세션 캐시 항목 수
+    int    sessionTimeoutSec = 3600;   // 세션/티켓 유효 시간
+    int    ticketRotateSec   = 3600;   // 세션 티켓 키 교체 주기 (0: 티켓 끔)
+
+    bool   ktls = false;  // SSL_OP_ENABLE_KTLS: 가능하면 GET_IMAGE 를 SSL_sendfile 로 전송
+    bool   ioUring = false;  // 스레드 모드 이미지 파일 I/O 를 io_uring 으로 (커널 지원 시)
+
+    int    workerThreads  = 0;     // 명령 실행 작업 스레드 수 (0: 코어 수)
+    int    queueCapacity  = 256;   // 작업 큐 최대 길이 (초과 시 503)
+    int    maxConnections = 1024;  // 동시 연결 상한 (초과 시 즉시 종료)
+    int    pipelineDepth  = 8;     // 한 연결에서 동시에 실행할 조회 명령 수 (1: 순차 실행)
+
+    std::string upgradeSocket;         // 무중단 재시작용 리스너 인계 Unix 소켓 경로 (비면 끔)
+    int    drainTimeoutSec = 30;       // 인계 후 남은 연결을 기다리는 최대 시간
+
+    std::string localSocket;           // 같은 기기 생산자용 평문 Unix 소켓 경로 (비면 끔)
+    int    localSocketMode = 0660;     // 소켓 파일 권한
+    int    localAllowUid   = -1;       // root, 서버 uid 외에 접속을 허용할 uid (-1: 없음)
+
+    LogOptions log;   // --log-level, --log-format, --log-file, --log-rate-limit
+
+    // 커맨드라인 인자 파싱 (--io=thread|reactor|coro, --loops=N, --workers=N ...)
+    static ServerConfig fromArgs(int argc, char* argv[]);
+};
+
+#endif // SERVER_CONFIG_HPP
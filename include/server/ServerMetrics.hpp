@@ -0,0 +1,84 @@
+#ifndef SERVER_METRICS_HPP
+#define SERVER_METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// 서버 전역 운영 지표 (모든 스레드에서 lock 없이 갱신)
+struct ServerMetrics {
+    // TLS 핸드쉐이크
+    std::atomic<int64_t>  handshakesInFlight{0};
+    std::atomic<uint64_t> handshakesCompleted{0};
+    std::atomic<uint64_t> handshakesFailed{0};
+    std::atomic<uint64_t> handshakesTimedOut{0};
+
+    // 제한 시간 초과로 닫은 연결 (핸드쉐이크 제외)
+    std::atomic<uint64_t> idleTimeouts{0};
+    std::atomic<uint64_t> headerTimeouts{0};   // 명령 줄을 끝까지 보내지 않음
+    std::atomic<uint64_t> uploadTimeouts{0};   // 업로드 본문 진행 없음
+
+    // TLS 세션 재개 (hit: 재개된 핸드쉐이크, miss: 전체 핸드쉐이크)
+    std::atomic<uint64_t> sessionHits{0};
+    std::atomic<uint64_t> sessionMisses{0};
+    std::atomic<uint64_t> ticketsIssued{0};
+    std::atomic<uint64_t> ticketsUnknownKey{0};  // 교체되어 사라진 키의 티켓
+
+    // GET_IMAGE 전송 경로
+    std::atomic<uint64_t> imagesSentKtls{0};      // SSL_sendfile (커널 TLS)
+    std::atomic<uint64_t> imagesSentBuffered{0};  // read + SSL_write
+    std::atomic<uint64_t> imagesSentUring{0};     // io_uring 선읽기 + SSL_write
+    std::atomic<uint64_t> uploadsUring{0};        // SSL_read + io_uring 쓰기
+    std::atomic<uint64_t> imageBytesSent{0};
+
+    // 응답 송신 (이미지 응답 포함). 레코드/응답 비율로 응답 합치기 효과를 본다
+    std::atomic<uint64_t> responsesSent{0};
+    std::atomic<uint64_t> tlsRecordsSent{0};
+
+    // 요청 아레나 (명령 파싱, 조회 행, 응답 JSON)
+    std::atomic<uint64_t> arenaRequests{0};
+    std::atomic<uint64_t> arenaBytesUsed{0};      // 누적 사용량
+    std::atomic<uint64_t> arenaBytesMax{0};       // 요청 하나의 최대 사용량
+    std::atomic<uint64_t> arenaOverflows{0};      // 초기 버퍼를 넘겨 힙에서 더 받은 요청
+    std::atomic<uint64_t> arenaOverflowBytes{0};
+
+    // 연결 수 제한
+    std::atomic<int64_t>  connectionsActive{0};
+    std::atomic<uint64_t> connectionsRejected{0};
+
+    // --local-socket 평문 연결
+    std::atomic<uint64_t> localConnections{0};
+    std::atomic<uint64_t> localRejected{0};   // SO_PEERCRED 검사 실패
+
+    // SUBSCRIBE_EVENTS 푸시
+    std::atomic<int64_t>  eventSubscribers{0};
+    std::atomic<uint64_t> eventsPublished{0};          // 커밋된 새 레코드
+    std::atomic<uint64_t> eventsQueued{0};             // 구독자 대기열에 넣은 수 (팬아웃)
+    std::atomic<uint64_t> eventsSent{0};
+    std::atomic<uint64_t> eventSubscribersDropped{0};  // 대기열이 넘쳐 끊은 구독자
+
+    // 명령 작업 풀
+    std::atomic<uint64_t> jobsSubmitted{0};
+    std::atomic<uint64_t> jobsRejected{0};    // 큐 포화로 503 응답
+    std::atomic<uint64_t> jobsCompleted{0};
+    std::atomic<uint64_t> jobsPipelined{0};   // 같은 연결의 앞선 명령과 동시에 실행
+    std::atomic<uint64_t> queueDepth{0};
+    std::atomic<uint64_t> queueDepthMax{0};
+    std::atomic<uint64_t> queueWaitTotalUs{0};
+    std::atomic<uint64_t> queueWaitMaxUs{0};
+
+    // GET_METRICS 응답의 data 부분 (JSON 객체 문자열)
+    std::string toJson() const;
+};
+
+// 프로세스 전역 인스턴스
+ServerMetrics& serverMetrics();
+
+// 최대값 지표 갱신 (CAS)
+inline void raiseMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t prev = target.load(std::memory_order_relaxed);
+    while (value > prev &&
+           !target.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+}
+
+#endif // SERVER_METRICS_HPP
@@ -5,18 +5,22 @@
 #include <string>
 #include <map>
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include <atomic>
 #include <fstream>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 
-class ImageHandler;   // forward declaration
+#include "server/ServerConfig.hpp"
 
-struct UploadSession {
-    std::string filename;
-    size_t      filesize;
-    size_t      received;
-    std::ofstream ofs;
-};
+class ImageHandler;   // forward declaration
+class EventLoop;
+class CoroLoop;
+class WorkerPool;
+class ConnectionWatchdog;
+class LocalListener;
+class ReadBuffer;
 
 class TcpServer {
 public:
@@ -24,22 +28,78 @@ public:
     explicit TcpServer(SSL_CTX* ctx);
     ~TcpServer();
 
-    // 소켓 생성/바인드/리스닝
+    // 소켓 생성/바인드/리스닝 (리액터/코루틴 + reusePort 면 루프 수만큼).
+    // upgradeSocket 에 실행 중인 서버가 있으면 bind 대신 리스너를 넘겨받는다
     void setupSocket(int port);
 
-    // 무한 루프에서 accept() → 쓰레드 생성
+    // 설정된 I/O 모델로 서버 루프 실행 (반환하지 않음)
     void start();
 
+    // 실행 전 설정 (I/O 모델, 루프 스레드 수 등)
+    void setConfig(const ServerConfig& cfg);
+
     // ImageHandler 연결
     void setImageHandler(ImageHandler* handler);
     bool handleClientSSL(int client_fd, SSL* ssl);
+
+    // 스레드 모드: 연결 스레드에서 제한 시간 내 TLS 핸드쉐이크 수행
+    bool acceptTls(int client_fd, SSL* ssl);
+
+    // 리액터 모드: accept 된 소켓을 이벤트 루프에 라운드로빈 분배
+    void dispatchConnection(int client_fd);
+
+    // 동시 연결 상한 검사. 받아들이면 true (종료 시 releaseConnection)
+    bool admitConnection();
+    void releaseConnection();
+
+    // 스레드 모드: 작업 풀에서 명령을 실행하고 결과를 기다린다 (포화 시 503)
+    std::string executeCommand(const std::string& cmd);
+    // 여러 명령을 동시에 실행하고 요청 순서대로 응답 반환
+    std::vector<std::string> executeCommands(const std::vector<std::string>& cmds);
+
+    ImageHandler* getImageHandler() const { return imageHandler; }
+    SSL_CTX*      getSslContext() const { return sslCtx; }
+    const ServerConfig& getConfig() const { return config; }
+    WorkerPool*   getWorkerPool() const { return pool.get(); }
+    // 스레드 모드와 로컬 소켓 연결의 제한 시간 감시 (둘 다 아니면 nullptr)
+    ConnectionWatchdog* getWatchdog() const { return watchdog.get(); }
+
 private:
-    // SSL 연결로 들어온 클라이언트 처리
-    
+    // 리스닝 소켓 하나 생성
+    int openListener(int port, bool reusePort);
+    // 리액터/코루틴 루프 수
+    int loopCount() const;
+    // 스레드 모드 명령 루프 (handleClientSSL 이 감시 해제를 보장)
+    bool serveClient(int client_fd, SSL* ssl);
+    // PROTO BINARY 협상 이후의 프레임 루프 (rbuf: 협상 줄 뒤에 이미 읽힌 바이트)
+    bool serveBinary(int client_fd, SSL* ssl, ReadBuffer& rbuf);
+
+    // 무한 루프에서 accept() → 쓰레드 생성 (기존 방식)
+    void startThreaded();
+    // epoll 이벤트 루프 N 개로 모든 연결 처리
+    void startReactor();
+    // 코루틴 루프 N 개로 모든 연결 처리 (연결마다 코루틴 하나)
+    void startCoro();
+    // --local-socket: 같은 기기 생산자용 평문 Unix 소켓 리스너 시작
+    void startLocal();
+    // --upgrade-socket: 새 서버의 인계 요청을 기다리는 스레드 시작
+    void startHandoff();
+    // 리스너를 넘겨준 뒤: accept 중단, 남은 요청을 마치고 프로세스 종료 (반환하지 않음)
+    void drain();
 
     int       server_fd;
+    std::vector<int> listenFds;   // reusePort 샤딩 시 루프별 리스너
+    int       acceptWakeFd;       // 스레드 모드 accept 루프를 깨우는 eventfd (인계 시)
     SSL_CTX*  sslCtx;             // TLS 설정 컨텍스트
     ImageHandler* imageHandler;   // 업로드 처리기
+    ServerConfig  config;
+
+    std::unique_ptr<WorkerPool>             pool;
+    std::unique_ptr<ConnectionWatchdog>     watchdog;  // 스레드 모드/로컬 소켓 제한 시간
+    std::unique_ptr<LocalListener>          local;     // --local-socket 평문 리스너
+    std::vector<std::unique_ptr<EventLoop>> loops;
+    std::vector<std::unique_ptr<CoroLoop>>  coroLoops;
+    std::atomic<size_t> nextLoop;
 };
 
 #endif // TCPSERVER_HPP
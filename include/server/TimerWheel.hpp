@@ -0,0 +1,45 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// 해시 타이머 휠. 마감 시각을 tick 단위 슬롯에 나눠 담아 등록/취소가 O(1) 이고,
+// 만료 검사는 지나간 tick 의 슬롯만 본다. 스레드 안전하지 않음 (호출자가 보호).
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimerWheel(std::chrono::milliseconds tick, size_t slotCount);
+
+    // id 의 마감 시각을 설정 (이미 있으면 교체)
+    void schedule(uint64_t id, Clock::time_point deadline);
+    void cancel(uint64_t id);
+    bool empty() const { return entries.empty(); }
+
+    // now 까지 마감이 지난 id 를 expired 에 추가하고 휠에서 뺀다
+    void advance(Clock::time_point now, std::vector<uint64_t>& expired);
+
+    // 다음 tick 까지 남은 시간 (ms). 등록된 타이머가 없으면 -1
+    int nextTimeoutMs(Clock::time_point now) const;
+
+private:
+    struct Entry {
+        uint64_t expireTick;
+        std::list<uint64_t>::iterator pos;
+    };
+
+    uint64_t ticksSinceOrigin(Clock::time_point t, bool roundUp) const;
+
+    std::chrono::milliseconds tick;
+    Clock::time_point         origin;
+    uint64_t                  current;  // 아직 검사하지 않은 첫 tick
+
+    std::vector<std::list<uint64_t>>       slots;
+    std::unordered_map<uint64_t, Entry>    entries;
+};
+
+#endif // TIMER_WHEEL_HPP
@@ -0,0 +1,20 @@
+#ifndef TLS_SESSION_CACHE_HPP
+#define TLS_SESSION_CACHE_HPP
+
+#include <openssl/ssl.h>
+
+#include "server/ServerConfig.hpp"
+
+// TLS 세션 재개 설정.
+// 재접속하는 클라이언트가 전체 핸드쉐이크(인증서 체인 검증 + 비대칭 연산)를
+// 반복하지 않도록 서버 세션 캐시와 주기적으로 키가 교체되는 세션 티켓을 켠다.
+class TlsSessionCache {
+public:
+    // SSL_CTX 에 세션 캐시/티켓 설정 (인증서 로드 후, 서버 시작 전 1회)
+    static void configure(SSL_CTX* ctx, const ServerConfig& cfg);
+
+    // 핸드쉐이크 완료 직후 호출: 재개 여부를 지표에 반영
+    static void recordHandshake(SSL* ssl);
+};
+
+#endif // TLS_SESSION_CACHE_HPP
@@ -0,0 +1,48 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 작업 큐 포화 시 즉시 보내는 응답
+inline constexpr const char* kServerBusyResponse =
+    R"({"status": "error", "code": 503, "message": "Server busy, try again later"})";
+
+// 고정 크기 작업 스레드 풀 + 제한된 작업 큐.
+// 큐가 가득 차면 작업을 받지 않고 호출자가 즉시 거절 응답을 보내게 한다.
+class WorkerPool {
+public:
+    WorkerPool(size_t threads, size_t queueCapacity);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // 작업 등록. 큐가 가득 찼으면 false
+    bool trySubmit(std::function<void()> job);
+
+    size_t queueDepth() const;
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        std::chrono::steady_clock::time_point enqueuedAt;
+    };
+
+    void workerLoop();
+
+    size_t capacity;
+    bool   stopping;
+
+    mutable std::mutex      mtx;
+    std::condition_variable cv;
+    std::deque<Job>         queue;
+    std::vector<std::thread> workers;
+};
+
+#endif // WORKER_POOL_HPP
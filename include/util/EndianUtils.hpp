@@ -7,4 +7,12 @@
 uint64_t htonll(uint64_t value);
 uint64_t ntohll(uint64_t value);
 
+// 바이트 버퍼에 big-endian(네트워크 순서) 정수 쓰기/읽기. 정렬되지 않은 위치도 가능
+void     writeBE16(void* dst, uint16_t value);
+void     writeBE32(void* dst, uint32_t value);
+void     writeBE64(void* dst, uint64_t value);
+uint16_t readBE16(const void* src);
+uint32_t readBE32(const void* src);
+uint64_t readBE64(const void* src);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+enum class LogFormat {
+    Text,    // "2025-01-01 12:00:00.123 INFO  메시지"
+    Json,    // 줄마다 {"ts":..,"level":..,"tid":..,"msg":..}
+    Binary   // 레코드마다 [u64 ns][u32 tid][u8 level][u8 0][u16 길이][메시지] (호스트 바이트 순서)
+};
+
+struct LogOptions {
+    LogLevel    level     = LogLevel::Info;
+    LogFormat   format    = LogFormat::Text;
+    std::string file;            // 비면 표준 출력
+    int         rateLimit = 100; // 호출 위치당 초당 최대 메시지 수 (0: 제한 없음, Error 는 항상 기록)
+};
+
+// 비동기 로거. 호출 스레드는 메시지를 링 버퍼 슬롯에 복사만 하고 (lock 없음),
+// 시각 포맷과 write 는 백그라운드 스레드가 모아서 한다. 버퍼가 가득 차면 버리고 센다.
+class Logger {
+public:
+    static constexpr size_t kSlots      = 4096;  // 2의 거듭제곱
+    static constexpr size_t kMaxMessage = 232;   // 넘으면 잘림
+
+    static Logger& instance();
+
+    // 출력 파일을 열고 기록 스레드 시작. 시작 전에는 호출 스레드에서 바로 쓴다
+    bool start(const LogOptions& options);
+    // 남은 메시지를 모두 쓰고 기록 스레드 종료 (종료/exec 직전에 호출)
+    void stop();
+
+    bool enabled(LogLevel level) const {
+        return static_cast<uint8_t>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+    int rateLimit() const { return rateLimitPerSec.load(std::memory_order_relaxed); }
+
+    // 메시지 한 건을 링 버퍼에 넣는다
+    void write(LogLevel level, const char* msg, size_t len);
+
+    // 지표
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};     // 링 버퍼가 가득 참
+    std::atomic<uint64_t> suppressed{0};  // 호출 위치별 초당 제한 초과
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        uint64_t timeNs;
+        uint32_t tid;
+        uint8_t  level;
+        uint16_t len;
+        char     text[kMaxMessage];
+    };
+
+    Logger();
+    ~Logger() { stop(); }
+    void   run();
+    bool   drainInto(std::string& out);
+    void   format(std::string& out, uint64_t timeNs, uint32_t tid, uint8_t level,
+                  const char* text, size_t len);
+    void   flush(std::string& out);
+    void   writeDirect(LogLevel level, const char* msg, size_t len);
+
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> head{0};   // 다음에 쓸 위치 (생산자)
+    uint64_t              tail = 0;  // 다음에 읽을 위치 (기록 스레드 전용)
+
+    std::atomic<uint8_t>  minLevel{static_cast<uint8_t>(LogLevel::Info)};
+    std::atomic<int>      rateLimitPerSec{100};
+    LogFormat             outFormat = LogFormat::Text;
+    int                   fd        = 1;
+    std::atomic<bool>     running{false};
+    std::thread           flusher;
+    uint64_t              reportedDropped    = 0;
+    uint64_t              reportedSuppressed = 0;
+};
+
+// 호출 위치별 초당 메시지 수 제한 (LOG_* 매크로가 위치마다 하나씩 둔다)
+class LogRateLimit {
+public:
+    bool allow();
+private:
+    std::atomic<int64_t>  window{-1};
+    std::atomic<uint32_t> count{0};
+};
+
+// 스택 버퍼에 메시지를 이어 붙인다 (문자열은 복사, 숫자는 to_chars)
+class LogLine {
+public:
+    LogLine& operator<<(std::string_view s) {
+        size_t n = s.size() < kCapacity - size ? s.size() : kCapacity - size;
+        s.copy(buf + size, n);
+        size += n;
+        return *this;
+    }
+    LogLine& operator<<(const char* s) { return *this << std::string_view(s ? s : "(null)"); }
+    LogLine& operator<<(const std::string& s) { return *this << std::string_view(s); }
+    LogLine& operator<<(char c) { return *this << std::string_view(&c, 1); }
+    LogLine& operator<<(bool b) { return *this << (b ? "true" : "false"); }
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    LogLine& operator<<(T value) {
+        auto [end, ec] = std::to_chars(buf + size, buf + kCapacity, value);
+        if (ec == std::errc()) size = static_cast<size_t>(end - buf);
+        return *this;
+    }
+
+    const char* data() const { return buf; }
+    size_t      length() const { return size; }
+
+private:
+    static constexpr size_t kCapacity = Logger::kMaxMessage;
+    char   buf[kCapacity];
+    size_t size = 0;
+};
+
+template <typename... Args>
+void logWrite(LogLevel level, const Args&... args) {
+    LogLine line;
+    (line << ... << args);
+    Logger::instance().write(level, line.data(), line.length());
+}
+
+// errno 설명을 붙여 Error 로 기록 (perror 대체)
+void logErrno(const char* what);
+// OpenSSL 에러 큐를 비우며 Error 로 기록 (ERR_print_errors_fp 대체)
+void logSslErrors();
+
+#define LOG_AT(lvl, ...)                                                     \
+    do {                                                                     \
+        if (Logger::instance().enabled(lvl)) {                               \
+            static LogRateLimit logRateLimit_;                               \
+            if ((lvl) == LogLevel::Error || logRateLimit_.allow())           \
+                logWrite(lvl, __VA_ARGS__);                                  \
+        }                                                                    \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+
+#endif // LOGGER_HPP
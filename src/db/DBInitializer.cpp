@@ -1,5 +1,5 @@
 #include "../../include/db/DBInitializer.hpp"
-#include <iostream>
+#include "../../include/util/Logger.hpp"
 
 using namespace std;
 
@@ -26,11 +26,64 @@ void DBInitializer::init(DBManager& db) {
         );
     )";
 
+    // 키셋 페이지네이션 ((date, id) 내림차순)과 날짜순 정렬용. 기존 DB 에는 처음 시작할 때 한 번 만들어진다
+    string createHistoryIndexes = R"(
+        CREATE INDEX IF NOT EXISTS idx_history_date_id ON history (date, id);
+        CREATE INDEX IF NOT EXISTS idx_history_type_date_id ON history (event_type, date, id);
+    )";
+
+    // 시간(YYYY-MM-DD HH)·유형별 건수 롤업 (GET_STATS). history 의 INSERT/DELETE/UPDATE 트리거가 같은 문장 안에서
+    // 갱신하므로 어느 경로로 바뀌어도 맞는다. 트리거가 아직 없는 DB (이 테이블 이전에 만든 DB) 는
+    // 트리거를 만드는 같은 트랜잭션에서 기존 행으로 한 번 채운다
+    string createHistoryStats = R"(
+        BEGIN IMMEDIATE;
+        CREATE TABLE IF NOT EXISTS history_stats (
+            hour TEXT NOT NULL,
+            event_type INTEGER NOT NULL,
+            count INTEGER NOT NULL,
+            PRIMARY KEY (hour, event_type)
+        ) WITHOUT ROWID;
+        DELETE FROM history_stats
+            WHERE NOT EXISTS (SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_history_stats_insert');
+        INSERT INTO history_stats (hour, event_type, count)
+            SELECT substr(date, 1, 13), event_type, COUNT(*) FROM history
+            WHERE NOT EXISTS (SELECT 1 FROM sqlite_master WHERE type = 'trigger' AND name = 'trg_history_stats_insert')
+            GROUP BY 1, 2;
+        CREATE TRIGGER IF NOT EXISTS trg_history_stats_insert AFTER INSERT ON history BEGIN
+            INSERT INTO history_stats (hour, event_type, count) VALUES (substr(NEW.date, 1, 13), NEW.event_type, 1)
+                ON CONFLICT (hour, event_type) DO UPDATE SET count = count + 1;
+        END;
+        CREATE TRIGGER IF NOT EXISTS trg_history_stats_delete AFTER DELETE ON history BEGIN
+            UPDATE history_stats SET count = count - 1
+                WHERE hour = substr(OLD.date, 1, 13) AND event_type = OLD.event_type;
+            DELETE FROM history_stats
+                WHERE hour = substr(OLD.date, 1, 13) AND event_type = OLD.event_type AND count <= 0;
+        END;
+        CREATE TRIGGER IF NOT EXISTS trg_history_stats_update AFTER UPDATE OF date, event_type ON history BEGIN
+            UPDATE history_stats SET count = count - 1
+                WHERE hour = substr(OLD.date, 1, 13) AND event_type = OLD.event_type;
+            DELETE FROM history_stats
+                WHERE hour = substr(OLD.date, 1, 13) AND event_type = OLD.event_type AND count <= 0;
+            INSERT INTO history_stats (hour, event_type, count) VALUES (substr(NEW.date, 1, 13), NEW.event_type, 1)
+                ON CONFLICT (hour, event_type) DO UPDATE SET count = count + 1;
+        END;
+        COMMIT;
+    )";
+
     if (!db.execute(createUserTable)) {
-        cerr << "[DBInitializer] Failed to create 'users' table." << endl;
+        LOG_ERROR("[DBInitializer] Failed to create 'users' table");
     }
 
     if (!db.execute(createHistoryTable)) {
-        cerr << "[DBInitializer] Failed to create 'history' table." << endl;
+        LOG_ERROR("[DBInitializer] Failed to create 'history' table");
+    }
+
+    if (!db.execute(createHistoryIndexes)) {
+        LOG_ERROR("[DBInitializer] Failed to create 'history' indexes");
+    }
+
+    if (!db.execute(createHistoryStats)) {
+        if (!sqlite3_get_autocommit(db.getDB())) db.execute("ROLLBACK;");
+        LOG_ERROR("[DBInitializer] Failed to create 'history_stats' rollup");
     }
 }
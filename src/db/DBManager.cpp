@@ -1,5 +1,5 @@
 #include "../../include/db/DBManager.hpp"
-#include <iostream>
+#include "../../include/util/Logger.hpp"
 
 using namespace std;
 
@@ -16,7 +16,7 @@ bool DBManager::open() {
         isOpen_ = true;
         return true;
     } else {
-        cerr << "[DBManager] Failed to open database: " << sqlite3_errmsg(db_) << endl;
+        LOG_ERROR("[DBManager] Failed to open database ", dbPath_, ": ", sqlite3_errmsg(db_));
         return false;
     }
 }
@@ -35,14 +35,14 @@ bool DBManager::isOpen() const {
 
 bool DBManager::execute(const string& query) {
     if (!isOpen_) {
-        cerr << "[DBManager] Database is not open." << endl;
+        LOG_ERROR("[DBManager] Database is not open");
         return false;
     }
 
     char* errMsg = nullptr;
     int result = sqlite3_exec(db_, query.c_str(), nullptr, nullptr, &errMsg);
     if (result != SQLITE_OK) {
-        cerr << "[DBManager] SQL error: " << errMsg << endl;
+        LOG_ERROR("[DBManager] SQL error: ", errMsg ? errMsg : sqlite3_errmsg(db_));
         sqlite3_free(errMsg);
         return false;
     }
@@ -1,19 +1,46 @@
 #include "../../include/db/repository/HistoryRepository.hpp"
-#include <iostream>
+#include "../../include/util/Logger.hpp"
+#include <cstring>
 
-HistoryRepository::HistoryRepository(sqlite3* db) : db(db) {}
+namespace {
 
-// 히스토리 생성
-bool HistoryRepository::createHistory(const History& history) {
-    const char* sql = "INSERT INTO history (date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed) VALUES (?, ?, ?, ?, ?, ?, ?)";
+// 컬럼 텍스트를 복사하지 않고 (다음 sqlite3_step 전까지 유효, NULL 이면 빈 문자열)
+std::string_view columnView(sqlite3_stmt* stmt, int col) {
+    const unsigned char* text = sqlite3_column_text(stmt, col);
+    int len = sqlite3_column_bytes(stmt, col);
+    if (!text || len <= 0) return {};
+    return std::string_view(reinterpret_cast<const char*>(text), len);
+}
+
+// 연결의 SQLite 뮤텍스 (직렬화 모드). 잡고 있는 동안 다른 스레드는 이 연결의 어떤 API 도 부를 수 없으므로
+// 작업 스레드들이 공유하는 연결에서 여러 호출에 걸친 쓰기 (명시적 트랜잭션, 실행 뒤 sqlite3_changes) 에
+// 다른 저장소의 문장이 끼어들지 않는다. 재귀 뮤텍스라 잡은 채로 SQLite 를 호출해도 된다
+class ConnectionLock {
+public:
+    explicit ConnectionLock(sqlite3* db) : mutex(sqlite3_db_mutex(db)) { sqlite3_mutex_enter(mutex); }
+    ~ConnectionLock() { sqlite3_mutex_leave(mutex); }
+    ConnectionLock(const ConnectionLock&) = delete;
+    ConnectionLock& operator=(const ConnectionLock&) = delete;
+
+private:
+    sqlite3_mutex* mutex;
+};
+
+sqlite3_stmt* prepare(sqlite3* db, const char* sql) {
     sqlite3_stmt* stmt;
-    
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr);
-    if (rc != SQLITE_OK) {
-        std::cerr << "Failed to prepare INSERT statement: " << sqlite3_errmsg(db) << std::endl;
-        return false;
-    }
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return nullptr;
+    return stmt;
+}
+
+// RETURNING: 작업 스레드들이 연결을 공유하므로 last_insert_rowid 대신 문장 결과로 id 를 받는다
+sqlite3_stmt* prepareInsert(sqlite3* db) {
+    return prepare(db,
+        "INSERT INTO history (date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?) RETURNING id");
+}
 
+// 준비된 INSERT 에 바인딩하고 실행해 새 id 를 돌려준다. 실패하면 -1 (stmt 는 호출자가 reset/finalize)
+int insertHistory(sqlite3* db, sqlite3_stmt* stmt, const History& history) {
     sqlite3_bind_text(stmt, 1, history.date.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, history.imagePath.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 3, history.plateNumber.c_str(), -1, SQLITE_TRANSIENT);
@@ -24,17 +51,106 @@ bool HistoryRepository::createHistory(const History& history) {
         sqlite3_bind_double(stmt, 7, history.speed.value());
     else
         sqlite3_bind_null(stmt, 7);
-    rc = sqlite3_step(stmt);
+    int rc = sqlite3_step(stmt);
+    int id = -1;
+    if (rc == SQLITE_ROW) {
+        id = sqlite3_column_int(stmt, 0);
+        rc = sqlite3_step(stmt);
+    }
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to execute INSERT: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[HistoryRepository] Failed to execute INSERT: ", sqlite3_errmsg(db));
+        return -1;
+    }
+    return id;
+}
+
+} // namespace
+
+HistoryRepository::HistoryRepository(sqlite3* db) : db(db) {}
+
+// 히스토리 생성
+bool HistoryRepository::createHistory(const History& history) {
+    int id;
+    {
+        ConnectionLock lock(db);
+        sqlite3_stmt* stmt = prepareInsert(db);
+        if (!stmt) {
+            LOG_ERROR("[HistoryRepository] Failed to prepare INSERT statement: ", sqlite3_errmsg(db));
+            return false;
+        }
+        id = insertHistory(db, stmt, history);
         sqlite3_finalize(stmt);
-        return false;
     }
+    if (id < 0) return false;
 
-    sqlite3_finalize(stmt);
+    if (onInsert) {
+        History inserted = history;
+        inserted.id = id;
+        onInsert(inserted);
+    }
+    return true;
+}
+
+// 여러 건을 트랜잭션 하나로: INSERT 는 한 번만 준비해 재사용하고, 디스크 동기화는 커밋 때 한 번.
+// 제약 위반 같은 문장 오류는 그 건만 되돌려지고 나머지는 커밋한다. 오류로 SQLite 가 트랜잭션 전체를
+// 되돌렸으면 (SQLITE_FULL, IOERR, NOMEM 등) 남은 건을 자동 커밋으로 흘리지 않고 묶음 전체를 실패로 끝낸다
+bool HistoryRepository::createHistories(const std::vector<History>& histories, std::vector<int>& ids) {
+    ids.assign(histories.size(), -1);
+    if (histories.empty()) return true;
+
+    {
+        // 작업 스레드들이 연결을 공유하므로 BEGIN ~ COMMIT 동안 다른 스레드의 문장 (단건 INSERT, 삭제,
+        // 다른 저장소의 쓰기) 이 이 트랜잭션 안에서 실행되거나 ROLLBACK 에 휩쓸리지 않게 연결을 잡는다
+        ConnectionLock lock(db);
+
+        if (sqlite3_exec(db, "BEGIN IMMEDIATE;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+            LOG_ERROR("[HistoryRepository] Failed to begin batch transaction: ", sqlite3_errmsg(db));
+            return false;
+        }
+
+        sqlite3_stmt* stmt = prepareInsert(db);
+        if (!stmt) {
+            LOG_ERROR("[HistoryRepository] Failed to prepare INSERT statement: ", sqlite3_errmsg(db));
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return false;
+        }
+        for (size_t i = 0; i < histories.size(); ++i) {
+            ids[i] = insertHistory(db, stmt, histories[i]);
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+            if (ids[i] < 0 && sqlite3_get_autocommit(db)) {
+                LOG_ERROR("[HistoryRepository] Batch transaction rolled back by SQLite at record ", i);
+                sqlite3_finalize(stmt);
+                ids.assign(histories.size(), -1);
+                return false;
+            }
+        }
+        sqlite3_finalize(stmt);
+
+        if (sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+            LOG_ERROR("[HistoryRepository] Failed to commit batch transaction: ", sqlite3_errmsg(db));
+            sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+            ids.assign(histories.size(), -1);
+            return false;
+        }
+    }
+
+    // 커밋된 뒤에만 알린다
+    if (onInsert) {
+        for (size_t i = 0; i < histories.size(); ++i) {
+            if (ids[i] < 0) continue;
+            History inserted = histories[i];
+            inserted.id = ids[i];
+            onInsert(inserted);
+        }
+    }
     return true;
 }
 
+void HistoryRepository::setInsertListener(InsertListener listener) {
+    onInsert = std::move(listener);
+}
+
 // 페이지네이션 적용 전체 조회
 std::vector<History> HistoryRepository::getHistories(int limit, int offset) {
     std::vector<History> histories;
@@ -243,11 +359,211 @@ std::vector<History> HistoryRepository::getHistoriesByEventTypeAndDateRange(
 }
 
 
+bool HistoryRepository::visitRows(sqlite3_stmt* stmt, const RowVisitor& visit) {
+    if (!stmt) {
+        LOG_ERROR("[HistoryRepository] Failed to prepare SELECT statement: ", sqlite3_errmsg(db));
+        return false;
+    }
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        HistoryRow row;
+        row.id            = sqlite3_column_int(stmt, 0);
+        row.date          = columnView(stmt, 1);
+        row.imagePath     = columnView(stmt, 2);
+        row.plateNumber   = columnView(stmt, 3);
+        row.eventType     = sqlite3_column_int(stmt, 4);
+        row.startSnapshot = columnView(stmt, 5);
+        row.endSnapshot   = columnView(stmt, 6);
+        if (sqlite3_column_type(stmt, 7) != SQLITE_NULL)
+            row.speed = static_cast<float>(sqlite3_column_double(stmt, 7));
+        if (!visit(row)) {
+            rc = SQLITE_DONE;  // 호출자가 멈춘 것은 실패가 아니다
+            break;
+        }
+    }
+    if (rc != SQLITE_DONE) {
+        LOG_ERROR("[HistoryRepository] Failed to read history: ", sqlite3_errmsg(db));
+    }
+    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
+}
+
+sqlite3_stmt* HistoryRepository::selectHistories(int limit, int offset) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (stmt) {
+        sqlite3_bind_int(stmt, 1, limit);
+        sqlite3_bind_int(stmt, 2, offset);
+    }
+    return stmt;
+}
+
+sqlite3_stmt* HistoryRepository::selectByEventType(int eventType, int limit, int offset) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history WHERE event_type = ? ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (stmt) {
+        sqlite3_bind_int(stmt, 1, eventType);
+        sqlite3_bind_int(stmt, 2, limit);
+        sqlite3_bind_int(stmt, 3, offset);
+    }
+    return stmt;
+}
+
+sqlite3_stmt* HistoryRepository::selectByDateRange(std::string_view startDate, std::string_view endDate,
+                                                   int limit, int offset) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history WHERE date BETWEEN ? AND ? ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (stmt) {
+        sqlite3_bind_text(stmt, 1, startDate.data(), static_cast<int>(startDate.size()), SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, endDate.data(), static_cast<int>(endDate.size()), SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 3, limit);
+        sqlite3_bind_int(stmt, 4, offset);
+    }
+    return stmt;
+}
+
+sqlite3_stmt* HistoryRepository::selectByEventTypeAndDateRange(int eventType, std::string_view startDate,
+                                                               std::string_view endDate, int limit, int offset) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history WHERE event_type = ? AND date BETWEEN ? AND ? "
+        "ORDER BY date DESC LIMIT ? OFFSET ?;");
+    if (stmt) {
+        sqlite3_bind_int(stmt, 1, eventType);
+        sqlite3_bind_text(stmt, 2, startDate.data(), static_cast<int>(startDate.size()), SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, endDate.data(), static_cast<int>(endDate.size()), SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 4, limit);
+        sqlite3_bind_int(stmt, 5, offset);
+    }
+    return stmt;
+}
+
+bool HistoryRepository::getHistories(int limit, int offset, const RowVisitor& visit) {
+    return visitRows(selectHistories(limit, offset), visit);
+}
+
+bool HistoryRepository::getHistoriesByEventType(int eventType, int limit, int offset, const RowVisitor& visit) {
+    return visitRows(selectByEventType(eventType, limit, offset), visit);
+}
+
+bool HistoryRepository::getHistoriesByDateRange(std::string_view startDate, std::string_view endDate,
+                                                int limit, int offset, const RowVisitor& visit) {
+    return visitRows(selectByDateRange(startDate, endDate, limit, offset), visit);
+}
+
+bool HistoryRepository::getHistoriesByEventTypeAndDateRange(int eventType, std::string_view startDate,
+                                                            std::string_view endDate, int limit, int offset,
+                                                            const RowVisitor& visit) {
+    return visitRows(selectByEventTypeAndDateRange(eventType, startDate, endDate, limit, offset), visit);
+}
+
+sqlite3_stmt* HistoryRepository::selectSince(int lastId, int limit) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history WHERE id > ? ORDER BY id ASC LIMIT ?;");
+    if (stmt) {
+        sqlite3_bind_int(stmt, 1, lastId);
+        sqlite3_bind_int(stmt, 2, limit);
+    }
+    return stmt;
+}
+
+bool HistoryRepository::getHistoriesSince(int lastId, int limit, const RowVisitor& visit) {
+    return visitRows(selectSince(lastId, limit), visit);
+}
+
+
+sqlite3_stmt* HistoryRepository::selectPage(const int* eventType, const std::string_view* startDate,
+                                            const std::string_view* endDate, const HistoryCursor* after, int limit) {
+    std::string sql =
+        "SELECT id, date, image_path, plate_number, event_type, start_snapshot, end_snapshot, speed "
+        "FROM history WHERE 1";
+    if (eventType) sql += " AND event_type = ?";
+    if (startDate) sql += " AND date BETWEEN ? AND ?";
+    if (after) sql += " AND (date, id) < (?, ?)";
+    sql += " ORDER BY date DESC, id DESC LIMIT ?;";
+
+    sqlite3_stmt* stmt = prepare(db, sql.c_str());
+    if (!stmt) return nullptr;
+    int index = 1;
+    if (eventType) sqlite3_bind_int(stmt, index++, *eventType);
+    if (startDate) {
+        sqlite3_bind_text(stmt, index++, startDate->data(), static_cast<int>(startDate->size()), SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, index++, endDate->data(), static_cast<int>(endDate->size()), SQLITE_TRANSIENT);
+    }
+    if (after) {
+        sqlite3_bind_text(stmt, index++, after->date.data(), static_cast<int>(after->date.size()), SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, index++, after->id);
+    }
+    sqlite3_bind_int(stmt, index, limit);
+    return stmt;
+}
+
+bool HistoryRepository::getHistoriesPage(const HistoryCursor* after, int limit, const RowVisitor& visit) {
+    return visitRows(selectPage(nullptr, nullptr, nullptr, after, limit), visit);
+}
+
+bool HistoryRepository::getHistoriesByEventTypePage(int eventType, const HistoryCursor* after, int limit,
+                                                    const RowVisitor& visit) {
+    return visitRows(selectPage(&eventType, nullptr, nullptr, after, limit), visit);
+}
+
+bool HistoryRepository::getHistoriesByDateRangePage(std::string_view startDate, std::string_view endDate,
+                                                    const HistoryCursor* after, int limit, const RowVisitor& visit) {
+    return visitRows(selectPage(nullptr, &startDate, &endDate, after, limit), visit);
+}
+
+bool HistoryRepository::getHistoriesByEventTypeAndDateRangePage(int eventType, std::string_view startDate,
+                                                                std::string_view endDate, const HistoryCursor* after,
+                                                                int limit, const RowVisitor& visit) {
+    return visitRows(selectPage(&eventType, &startDate, &endDate, after, limit), visit);
+}
+
+
+bool HistoryRepository::getStats(std::string_view startDate, std::string_view endDate, bool hourly,
+                                 const StatsVisitor& visit) {
+    sqlite3_stmt* stmt = prepare(db,
+        "SELECT CASE WHEN ?3 THEN hour || ':00' ELSE substr(hour, 1, 10) END AS period, event_type, SUM(count) "
+        "FROM history_stats WHERE hour BETWEEN ?1 || ' 00' AND ?2 || ' 23' "
+        "GROUP BY period, event_type ORDER BY period, event_type;");
+    if (!stmt) {
+        LOG_ERROR("[HistoryRepository] Failed to prepare stats query: ", sqlite3_errmsg(db));
+        return false;
+    }
+    sqlite3_bind_text(stmt, 1, startDate.data(), static_cast<int>(startDate.size()), SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, endDate.data(), static_cast<int>(endDate.size()), SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 3, hourly ? 1 : 0);
+
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        HistoryStatsRow row;
+        row.period = columnView(stmt, 0);
+        row.eventType = sqlite3_column_int(stmt, 1);
+        row.count = sqlite3_column_int64(stmt, 2);
+        if (!visit(row)) {
+            rc = SQLITE_DONE;
+            break;
+        }
+    }
+    if (rc != SQLITE_DONE) {
+        LOG_ERROR("[HistoryRepository] Failed to read stats: ", sqlite3_errmsg(db));
+    }
+    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE;
+}
+
+
 // 히스토리 삭제
 bool HistoryRepository::deleteHistory(int id) {
     const char* sql = "DELETE FROM history WHERE id = ?;";
     sqlite3_stmt* stmt;
 
+    // 묶음 트랜잭션에 끼어들지 않고, sqlite3_changes 가 다른 스레드의 쓰기로 바뀌지 않게
+    ConnectionLock lock(db);
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
         return false;
     }
@@ -264,4 +580,3 @@ bool HistoryRepository::deleteHistory(int id) {
     // 실제로 삭제된 row가 있는지 확인 (0이면 해당 ID가 없던 것)
     return sqlite3_changes(db) > 0;
 }
-
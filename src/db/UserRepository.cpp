@@ -1,5 +1,5 @@
 #include "../../include/db/repository/UserRepository.hpp"
-#include <iostream>
+#include "../../include/util/Logger.hpp"
 
 UserRepository::UserRepository(sqlite3* db) : db(db) {}
 
@@ -9,7 +9,7 @@ bool UserRepository::createUser(const User& user) {
     sqlite3_stmt* stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to prepare statement: ", sqlite3_errmsg(db));
         return false;
     }
 
@@ -21,7 +21,7 @@ bool UserRepository::createUser(const User& user) {
     // 실행
     int rc = sqlite3_step(stmt);
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to execute statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to execute statement: ", sqlite3_errmsg(db));
         sqlite3_finalize(stmt);
         return false;
     }
@@ -31,16 +31,16 @@ bool UserRepository::createUser(const User& user) {
 }
 
 // 2. 사용자 조회 (Email)
-std::optional<User> UserRepository::getUserByEmail(const std::string& email) {
+std::optional<User> UserRepository::getUserByEmail(std::string_view email) {
     const char* sql = "SELECT id, email, password_hash, created_at FROM users WHERE email = ?;";
     sqlite3_stmt* stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "Failed to prepare SELECT statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to prepare SELECT statement: ", sqlite3_errmsg(db));
         return std::nullopt;
     }
 
-    sqlite3_bind_text(stmt, 1, email.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 1, email.data(), static_cast<int>(email.size()), SQLITE_TRANSIENT);
 
     int rc = sqlite3_step(stmt);
     if (rc == SQLITE_ROW) {
@@ -64,7 +64,7 @@ std::optional<User> UserRepository::getUserById(int id) {
     sqlite3_stmt* stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "Failed to prepare SELECT statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to prepare SELECT statement: ", sqlite3_errmsg(db));
         return std::nullopt;
     }
 
@@ -92,7 +92,7 @@ bool UserRepository::updateUserPassword(int id, const std::string& newPasswordHa
     sqlite3_stmt* stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "Failed to prepare UPDATE statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to prepare UPDATE statement: ", sqlite3_errmsg(db));
         return false;
     }
 
@@ -102,7 +102,7 @@ bool UserRepository::updateUserPassword(int id, const std::string& newPasswordHa
 
     int rc = sqlite3_step(stmt);
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to execute UPDATE statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to execute UPDATE statement: ", sqlite3_errmsg(db));
         sqlite3_finalize(stmt);
         return false;
     }
@@ -117,7 +117,7 @@ bool UserRepository::deleteUser(int id) {
     sqlite3_stmt* stmt;
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "Failed to prepare DELETE statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to prepare DELETE statement: ", sqlite3_errmsg(db));
         return false;
     }
 
@@ -127,7 +127,7 @@ bool UserRepository::deleteUser(int id) {
     // 쿼리 실행
     int rc = sqlite3_step(stmt);
     if (rc != SQLITE_DONE) {
-        std::cerr << "Failed to execute DELETE statement: " << sqlite3_errmsg(db) << std::endl;
+        LOG_ERROR("[UserRepository] Failed to execute DELETE statement: ", sqlite3_errmsg(db));
         sqlite3_finalize(stmt);
         return false;
     }
@@ -135,7 +135,7 @@ bool UserRepository::deleteUser(int id) {
     // 실제 삭제된 행이 없으면 실패로 판단
     int changes = sqlite3_changes(db);
     if (changes == 0) {
-        std::cerr << "Delete failed: No user found with ID = " << id << std::endl;
+        LOG_ERROR("[UserRepository] Delete failed: No user found with ID = ", id);
         sqlite3_finalize(stmt);
         return false;
     }
@@ -2,20 +2,25 @@
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include "server/TcpServer.hpp"
+#include "server/ServerConfig.hpp"
+#include "server/TlsSessionCache.hpp"
 #include "server/CommandHandler.hpp"
 #include "server/ImageHandler.hpp"
 #include "db/DBManager.hpp"
 #include "db/DBInitializer.hpp"
-
-#include <iostream>
+#include "util/Logger.hpp"
 
 // 전역 포인터 선언 (handleClientSSL 에서 사용)
 CommandHandler* commandHandler = nullptr;
 
-int main() {
+int main(int argc, char* argv[]) {
     // SIGPIPE 방지
     signal(SIGPIPE, SIG_IGN);
 
+    ServerConfig config = ServerConfig::fromArgs(argc, argv);
+    // 로그 기록 스레드 시작 (이후 LOG_* 는 링 버퍼에 넣기만 한다)
+    Logger::instance().start(config.log);
+
     // ─── OpenSSL 초기화 ────────────────────────────────
     SSL_library_init();
     OpenSSL_add_all_algorithms();
@@ -23,7 +28,7 @@ int main() {
     const SSL_METHOD* method = TLS_server_method();
     SSL_CTX* sslCtx = SSL_CTX_new(method);
     if (!sslCtx) {
-        ERR_print_errors_fp(stderr);
+        logSslErrors();
         return 1;
     }
 
@@ -31,24 +36,24 @@ int main() {
     if (SSL_CTX_use_certificate_file(sslCtx,
             "/home/sejin/myCA/tcp_server/certs/tcp_server.cert.pem",
             SSL_FILETYPE_PEM) <= 0) {
-        ERR_print_errors_fp(stderr);
+        logSslErrors();
         return 1;
     }
     if (SSL_CTX_use_PrivateKey_file(sslCtx,
             "/home/sejin/myCA/tcp_server/private/tcp_server.key.pem",
             SSL_FILETYPE_PEM) <= 0) {
-        ERR_print_errors_fp(stderr);
+        logSslErrors();
         return 1;
     }
     if (!SSL_CTX_check_private_key(sslCtx)) {
-        std::cerr << "Private key does not match the certificate\n";
+        LOG_ERROR("Private key does not match the certificate");
         return 1;
     }
 
     // CA 로드 (클라이언트 인증서 검증용)
     if (!SSL_CTX_load_verify_locations(sslCtx,
             "/home/sejin/myCA/certs/ca.cert.pem", nullptr)) {
-        ERR_print_errors_fp(stderr);
+        logSslErrors();
         return 1;
     }
 
@@ -63,12 +68,24 @@ int main() {
         SSL_OP_NO_COMPRESSION |
         SSL_OP_CIPHER_SERVER_PREFERENCE
     );
+
+    // 세션 캐시 + 티켓: 재접속 시 인증서 검증/비대칭 연산 생략
+    TlsSessionCache::configure(sslCtx, config);
+
+    // 커널 TLS: 지원되는 커널/암호군이면 GET_IMAGE 본문을 SSL_sendfile 로 전송
+    if (config.ktls) {
+#ifdef SSL_OP_ENABLE_KTLS
+        SSL_CTX_set_options(sslCtx, SSL_OP_ENABLE_KTLS);
+#else
+        LOG_WARN("[Main] --ktls ignored: OpenSSL built without kTLS");
+#endif
+    }
     // ────────────────────────────────────────────────────
 
     // 1. DB 연결
     DBManager db("server_data.db");
     if (!db.open()) {
-        std::cerr << "Failed to open DB\n";
+        LOG_ERROR("Failed to open DB");
         return 1;
     }
     // 2. 테이블 생성
@@ -76,15 +93,21 @@ int main() {
 
     // 3. 핸들러 생성
     ImageHandler imageHandler(db.getDB());                  // 먼저 생성
+    // io_uring: 커널이 지원하지 않으면 기존 read/write 경로 유지
+    if (config.ioUring && !imageHandler.setIoUring(true)) {
+        LOG_WARN("[Main] --io-uring ignored: io_uring unavailable, using read/write");
+    }
 CommandHandler handler(db.getDB(), &imageHandler);      // ✅ 인자 2개 전달
 commandHandler = &handler;
 
     // 4. 서버 실행
     TcpServer server(sslCtx);
+    server.setConfig(config);
     server.setImageHandler(&imageHandler);
     server.setupSocket(8080);
     server.start();
 
     SSL_CTX_free(sslCtx);
+    Logger::instance().stop();
     return 0;
 }
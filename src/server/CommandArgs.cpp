@@ -0,0 +1,92 @@
+// src/server/CommandArgs.cpp
+
+#include <charconv>
+#include <cmath>
+
+#include "server/CommandArgs.hpp"
+
+namespace {
+
+constexpr bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// from 부터 공백이 아닌(skipSpace) 또는 공백인 첫 위치. 없으면 s.size()
+size_t scan(std::string_view s, size_t from, bool skipSpace) {
+    while (from < s.size() && isSpace(s[from]) == skipSpace) ++from;
+    return from;
+}
+
+// 토큰 전체가 하나의 숫자일 때만
+template <typename T>
+bool parseNumber(std::string_view token, T& value) {
+    const char* end = token.data() + token.size();
+    T parsed{};
+    auto [ptr, ec] = std::from_chars(token.data(), end, parsed);
+    if (ec != std::errc() || ptr != end) return false;
+    value = parsed;
+    return true;
+}
+
+} // namespace
+
+bool ArgReader::next(std::string_view& token) {
+    size_t start = scan(rest, 0, true);
+    size_t end = scan(rest, start, false);
+    token = rest.substr(start, end - start);
+    rest.remove_prefix(end);
+    return !token.empty();
+}
+
+bool ArgReader::done() {
+    return scan(rest, 0, true) == rest.size();
+}
+
+bool parseArg(std::string_view token, std::string_view& value) {
+    value = token;
+    return true;
+}
+
+bool parseArg(std::string_view token, int& value) {
+    return parseNumber(token, value);
+}
+
+bool parseArg(std::string_view token, size_t& value) {
+    return parseNumber(token, value);
+}
+
+bool parseArg(std::string_view token, float& value) {
+    float parsed;
+    if (!parseNumber(token, parsed) || !std::isfinite(parsed)) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseArg(std::string_view token, std::optional<float>& value) {
+    if (token == "-") {
+        value = std::nullopt;
+        return true;
+    }
+    float parsed;
+    if (!parseArg(token, parsed)) return false;
+    value = parsed;
+    return true;
+}
+
+bool parseArg(std::string_view token, DateArg& value) {
+    if (token.size() != 10 || token[4] != '-' || token[7] != '-') return false;
+    for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (token[i] < '0' || token[i] > '9') return false;
+    }
+    int month = (token[5] - '0') * 10 + (token[6] - '0');
+    int day = (token[8] - '0') * 10 + (token[9] - '0');
+    if (month < 1 || month > 12 || day < 1 || day > 31) return false;
+    value.value = token;
+    return true;
+}
+
+std::string_view commandArgs(std::string_view line) {
+    size_t space = scan(line, scan(line, 0, true), false);
+    std::string_view args = line.substr(space);
+    return args.substr(0, args.find('\n'));
+}
@@ -1,5 +1,11 @@
 #include "../../include/server/CommandHandler.hpp"
-#include <json.hpp> // nlohmann::json 사용을 위해
+#include "../../include/server/CommandArgs.hpp"
+#include "../../include/server/CommandTable.hpp"
+#include "../../include/server/EventBroadcaster.hpp"
+#include "../../include/server/JsonWriter.hpp"
+#include "../../include/server/RequestArena.hpp"
+#include "../../include/server/ServerMetrics.hpp"
+#include <json.hpp> // ArenaJson 사용을 위해
 #include <openssl/sha.h> // SHA-256 해시를 위해
 #include <sstream>
 #include <iomanip>
@@ -7,42 +13,317 @@
 #include <filesystem> // 파일 경로 처리를 위해
 #include <fstream>
 
+namespace {
+
+// 응답 JSON 은 요청 아레나에 만든다 (노드, 배열, 문자열 모두)
+using ArenaJson = nlohmann::basic_json<std::map, std::vector, ArenaString, bool,
+                                       std::int64_t, std::uint64_t, double, ArenaAllocator>;
+
+// 직렬화 결과만 요청 밖으로 나가는 힙 문자열로
+std::string toResponse(const ArenaJson& response) {
+    ArenaString out = response.dump();
+    return std::string(out.data(), out.size());
+}
+
+// ADD_HISTORY 인자 (date image plate type [start end speed]) → History. 형식이 틀리면 false
+bool parseHistory(std::string_view args, History& history) {
+    std::string_view rawDate, imagePath, plateNumber, startSnapshot, endSnapshot;
+    int eventType = -1;
+    std::optional<float> speed; // "-" 또는 생략이면 없음
+
+    if (!parseArgs(args, 4, rawDate, imagePath, plateNumber, eventType, startSnapshot, endSnapshot, speed) ||
+        eventType < 0 || eventType > 2) {
+        return false;
+    }
+
+    // 날짜 형식 변경: YYYY-MM-DD_HH:MM:SS → YYYY-MM-DD HH:MM:SS
+    history.date = rawDate;
+    std::replace(history.date.begin(), history.date.end(), '_', ' ');
+    history.imagePath = imagePath;
+    history.plateNumber = plateNumber;
+    history.eventType = static_cast<int>(eventType);
+    history.startSnapshot = startSnapshot;
+    history.endSnapshot = endSnapshot;
+    if (eventType == 1 && speed.has_value() && *speed >= 0) // 속도위반일 때만
+        history.speed = speed;
+    else
+        history.speed = std::nullopt;
+    return true;
+}
+
+// JSON 객체 문자열 필드. 없으면 required 에 따라 실패 또는 빈 문자열
+bool jsonField(const ArenaJson& item, const char* key, std::string& out, bool required) {
+    auto it = item.find(key);
+    if (it == item.end() || it->is_null()) return !required;
+    if (!it->is_string()) return false;
+    const ArenaString& value = it->get_ref<const ArenaString&>();
+    out.assign(value.data(), value.size());
+    return !out.empty() || !required;
+}
+
+// ADD_HISTORY_BATCH 의 JSON 한 건 ({"date", "image_path", "plate_number", "event_type",
+// "start_snapshot"?, "end_snapshot"?, "speed"?}) → History. 검사는 텍스트 형식과 같다
+bool parseHistory(const ArenaJson& item, History& history) {
+    if (!item.is_object()) return false;
+    auto type = item.find("event_type");
+    if (type == item.end() || !type->is_number_integer()) return false;
+    int64_t eventType = type->get<int64_t>();  // int 로 바로 읽으면 4294967296 이 0 으로 잘린다
+    if (eventType < 0 || eventType > 2) return false;
+    if (!jsonField(item, "date", history.date, true) ||
+        !jsonField(item, "image_path", history.imagePath, true) ||
+        !jsonField(item, "plate_number", history.plateNumber, true) ||
+        !jsonField(item, "start_snapshot", history.startSnapshot, false) ||
+        !jsonField(item, "end_snapshot", history.endSnapshot, false)) {
+        return false;
+    }
+    std::replace(history.date.begin(), history.date.end(), '_', ' ');
+    history.eventType = static_cast<int>(eventType);
+
+    history.speed = std::nullopt;
+    auto speed = item.find("speed");
+    if (speed != item.end() && !speed->is_null()) {
+        if (!speed->is_number()) return false;
+        float value = speed->get<float>();
+        if (eventType == 1 && value >= 0) history.speed = value; // 속도위반일 때만
+    }
+    return true;
+}
+
+// 소수 둘째 자리로 반올림한 속도 (기존 응답과 같은 float 연산)
+float roundedSpeed(float speed) {
+    return std::round(speed * 100) / 100.0f;
+}
+
+// GET_HISTORY, GET_HISTORY_BY_DATE_RANGE 의 행: 모든 필드를 쓰고 유형에 맞지 않는 값은 "" 또는 null
+// (키는 dump() 와 같은 사전 순)
+void writeHistoryRow(JsonWriter& json, const HistoryRow& h) {
+    bool parking = h.eventType == 0; // 불법주정차만 스냅샷 사용
+    json.beginObject();
+    json.key("date");           json.value(h.date);
+    json.key("end_snapshot");   json.value(parking ? h.endSnapshot : std::string_view());
+    json.key("event_type");     json.value(h.eventType);
+    json.key("id");             json.value(h.id);
+    json.key("image_path");     json.value(h.imagePath);
+    json.key("plate_number");   json.value(h.plateNumber);
+    json.key("speed");
+    if (h.eventType == 1 && h.speed.has_value()) json.value(roundedSpeed(h.speed.value())); // 과속만
+    else json.null();
+    json.key("start_snapshot"); json.value(parking ? h.startSnapshot : std::string_view());
+    json.endObject();
+}
+
+// GET_HISTORY_BY_EVENT_TYPE* 의 행: 유형에 해당하는 필드만 (알 수 없는 유형은 빼고)
+void writeTypedHistoryRow(JsonWriter& json, const HistoryRow& h) {
+    if (h.eventType < 0 || h.eventType > 2) return;
+    bool parking = h.eventType == 0;  // 불법주정차: 스냅샷, 속도 없음
+    bool speeding = h.eventType == 1; // 과속: 속도, 스냅샷 없음
+    json.beginObject();
+    json.key("date");               json.value(h.date);
+    if (parking) { json.key("end_snapshot"); json.value(h.endSnapshot); }
+    json.key("event_type");         json.value(h.eventType);
+    json.key("id");                 json.value(h.id);
+    json.key("image_path");         json.value(h.imagePath);
+    if (h.eventType != 2) { json.key("plate_number"); json.value(h.plateNumber); } // 어린이 감지는 번호판 없음
+    if (speeding && h.speed.has_value()) { json.key("speed"); json.value(roundedSpeed(h.speed.value())); }
+    if (parking) { json.key("start_snapshot"); json.value(h.startSnapshot); }
+    json.endObject();
+}
+
+constexpr const char* kHistoryReadFailed =
+    R"({"status": "error", "code": 500, "message": "Failed to read history"})";
+
+// 히스토리 조회 응답을 SQLite 커서에서 바로 응답 문자열에 쓴다 (행 목록이나 JSON 트리를 만들지 않음).
+// query 는 받은 visitor 로 조회를 실행하고, SQLite 가 실패했으면 false 를 돌려준다 (일부 행만 쓴 응답은 버린다)
+template <typename Query>
+std::string historyResponse(void (*writeRow)(JsonWriter&, const HistoryRow&), Query query) {
+    std::string out;
+    JsonWriter json(out);
+    json.beginObject();
+    json.key("code");    json.value(200);
+    json.key("data");
+    json.beginArray();
+    bool read = query([&](const HistoryRow& h) {
+        writeRow(json, h);
+        return json.ok();
+    });
+    if (!read) return kHistoryReadFailed;
+    json.endArray();
+    json.key("message"); json.value("History retrieved successfully");
+    json.key("status");  json.value("success");
+    json.endObject();
+
+    if (!json.ok()) {
+        return R"({"status": "error", "code": 500, "message": "Invalid UTF-8 in history record"})";
+    }
+    return out;
+}
+
+// 키셋 페이지 커서 "<date>,<id>" (날짜의 공백은 ADD_HISTORY 처럼 '_' 로 써서 토큰 하나로)
+std::string formatCursor(std::string_view date, int id) {
+    std::string cursor(date);
+    std::replace(cursor.begin(), cursor.end(), ' ', '_');
+    cursor += ',';
+    cursor += std::to_string(id);
+    return cursor;
+}
+
+// 커서 토큰을 date (공백 복원) 와 id 로. 형식이 틀리면 false
+bool parseCursor(std::string_view token, std::string& date, int& id) {
+    size_t comma = token.rfind(',');
+    if (comma == std::string_view::npos || comma == 0 || !parseArg(token.substr(comma + 1), id)) return false;
+    date.assign(token.substr(0, comma));
+    std::replace(date.begin(), date.end(), '_', ' ');
+    return true;
+}
+
+// 키셋 페이지 응답. limit + 1 행을 읽어 다음 페이지가 있는지 알아내고, 있으면 이 페이지 마지막 행을
+// next_cursor 로 (없으면 null). query(읽을 행 수, visitor) 로 조회를 실행한다 (실패하면 false)
+template <typename Query>
+std::string historyPageResponse(void (*writeRow)(JsonWriter&, const HistoryRow&), int limit, Query query) {
+    constexpr int kMaxPageSize = 1000;
+    limit = std::min(limit, kMaxPageSize);
+
+    std::string out;
+    JsonWriter json(out);
+    int count = 0;
+    bool more = false;
+    std::string lastDate; // 커서에서 가리키는 행 (SQLite 버퍼는 다음 행에서 바뀌므로 복사)
+    int lastId = -1;
+    json.beginObject();
+    json.key("code");        json.value(200);
+    json.key("data");
+    json.beginArray();
+    bool read = query(limit + 1, [&](const HistoryRow& h) {
+        if (count == limit) {
+            more = true;
+            return false;
+        }
+        writeRow(json, h);
+        lastDate.assign(h.date);
+        lastId = h.id;
+        ++count;
+        return json.ok();
+    });
+    if (!read) return kHistoryReadFailed;
+    json.endArray();
+    json.key("message");     json.value("History retrieved successfully");
+    json.key("next_cursor");
+    if (more) json.value(formatCursor(lastDate, lastId));
+    else json.null();
+    json.key("status");      json.value("success");
+    json.endObject();
+
+    if (!json.ok()) {
+        return R"({"status": "error", "code": 500, "message": "Invalid UTF-8 in history record"})";
+    }
+    return out;
+}
+
+// SUBSCRIBE_EVENTS 로 내보내는 한 줄. data 는 GET_HISTORY 행과 같은 형식
+// (구독자 모두가 공유하고 요청보다 오래 살아서 힙 문자열). 잘못된 UTF-8 이면 빈 문자열
+std::string historyEventLine(const History& h) {
+    HistoryRow row{h.id, h.date, h.imagePath, h.plateNumber, h.eventType, h.startSnapshot, h.endSnapshot, h.speed};
+    std::string line;
+    JsonWriter json(line);
+    json.beginObject();
+    json.key("data");  writeHistoryRow(json, row);
+    json.key("event"); json.value("history");
+    json.endObject();
+    if (!json.ok()) return {};
+    line.push_back('\n');
+    return line;
+}
+
+} // namespace
+
 CommandHandler::CommandHandler(sqlite3* db, ImageHandler* ih)
-    : userRepo(db), historyRepo(db), imageHandler_(ih) {}
+    : userRepo(db), historyRepo(db), imageHandler_(ih) {
+    // 커밋된 새 레코드를 구독자에게 (구독자가 없으면 직렬화하지 않는다)
+    historyRepo.setInsertListener([](const History& h) {
+        EventBroadcaster& broadcaster = EventBroadcaster::instance();
+        if (!broadcaster.hasSubscribers()) return;
+        std::string line = historyEventLine(h);
+        if (!line.empty()) broadcaster.publish(h.eventType, std::move(line));
+    });
+}
 
 std::string CommandHandler::handle(const std::string& commandStr) {
-    std::istringstream iss(commandStr);
-    std::string command;
-    std::getline(iss, command, ' ');
-    command.erase(0, command.find_first_not_of(" \t\r\n"));
-    command.erase(command.find_last_not_of(" \t\r\n") + 1);
-
-    std::string payload;
-    std::getline(iss, payload);
-
-    if (command == "REGISTER") return handleRegister(payload);
-    else if (command == "LOGIN") return handleLogin(payload);
-    else if (command == "RESET_PASSWORD") return handleResetPassword(payload);
-    else if (command == "GET_HISTORY") return handleGetHistory(payload);
-    else if (command == "ADD_HISTORY") return handleAddHistory(payload);
-    else if (command == "GET_HISTORY_BY_EVENT_TYPE") return handleGetHistoryByEventType(payload);
-    else if (command == "GET_HISTORY_BY_DATE_RANGE") return handleGetHistoryByDateRange(payload);
-    else if (command == "GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE") return handleGetHistoryByEventTypeAndDateRange(payload);
-    else if (command == "CHANGE_FRAME") return handleChangeFrame(payload);
-    else if (command == "GET_FRAME") return handleGetFrame(payload);
-    else if (command == "GET_LOG") return handleGetLog(payload);
-    else return R"({"status": "error", "code": 400, "message": "Unknown command"})";
+    // ArenaJson/ArenaString 임시 객체 (ADD_HISTORY_BATCH 배열 파싱, 프레임·로그·메트릭 응답, 날짜 범위 문자열)는
+    // 아레나에서 할당되고 반환 시 한꺼번에 비워진다. 히스토리 응답은 JsonWriter 가 std::string 에 바로 쓴다
+    RequestArena::Scope arena;
+
+    // 첫 공백까지 명령, 나머지 (줄 끝까지) 인자
+    std::string_view line(commandStr);
+    size_t space = line.find(' ');
+    std::string_view command = line.substr(0, space);
+    std::string_view payload = space == std::string_view::npos ? std::string_view() : line.substr(space + 1);
+
+    size_t first = command.find_first_not_of(" \t\r\n");
+    command = first == std::string_view::npos
+                  ? std::string_view()
+                  : command.substr(first, command.find_last_not_of(" \t\r\n") - first + 1);
+
+    const CommandInfo* info = lookupCommand(command);
+    if (!info) return R"({"status": "error", "code": 400, "message": "Unknown command"})";
+    // ADD_HISTORY_BATCH 는 바이너리 프레임으로 여러 줄을 받을 수 있고, 나머지는 첫 줄만
+    payload = info->id == CommandId::AddHistoryBatch
+                  ? payload.substr(0, payload.find_last_not_of("\r\n") + 1)
+                  : payload.substr(0, payload.find('\n'));
+    if (payload.size() > info->maxPayload) {
+        return R"({"status": "error", "code": 413, "message": "Payload too large"})";
+    }
+
+    // 첫 인자가 등록된 사용자여야 하는 명령은 분기 전에 한 번만 확인한다 (나머지 인자 형식은 각 핸들러가)
+    if (info->needsAuth) {
+        std::string_view email;
+        if (!ArgReader(payload).next(email)) {
+            return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+        }
+        if (!userRepo.getUserByEmail(email).has_value()) {
+            return R"({"status": "error", "code": 404, "message": "User not found"})";
+        }
+    }
+
+    switch (info->id) {
+        case CommandId::Register: return handleRegister(payload);
+        case CommandId::Login: return handleLogin(payload);
+        case CommandId::ResetPassword: return handleResetPassword(payload);
+        case CommandId::GetHistory: return handleGetHistory(payload);
+        case CommandId::AddHistory: return handleAddHistory(payload);
+        case CommandId::AddHistoryBatch: return handleAddHistoryBatch(payload);
+        case CommandId::GetHistoryByEventType: return handleGetHistoryByEventType(payload);
+        case CommandId::GetHistoryByDateRange: return handleGetHistoryByDateRange(payload);
+        case CommandId::GetHistoryByEventTypeAndDateRange: return handleGetHistoryByEventTypeAndDateRange(payload);
+        case CommandId::GetHistoryPage: return handleGetHistoryPage(payload);
+        case CommandId::GetHistoryByEventTypePage: return handleGetHistoryByEventTypePage(payload);
+        case CommandId::GetHistoryByDateRangePage: return handleGetHistoryByDateRangePage(payload);
+        case CommandId::GetHistoryByEventTypeAndDateRangePage: return handleGetHistoryByEventTypeAndDateRangePage(payload);
+        case CommandId::GetHistorySince: return handleGetHistorySince(payload);
+        case CommandId::GetStats: return handleGetStats(payload);
+        case CommandId::ChangeFrame: return handleChangeFrame(payload);
+        case CommandId::GetFrame: return handleGetFrame(payload);
+        case CommandId::GetLog: return handleGetLog(payload);
+        case CommandId::GetMetrics: return handleGetMetrics(payload);
+        // 연결을 구독 스트림으로 바꾸는 명령이라 텍스트 연결의 명령 루프가 직접 처리한다
+        case CommandId::SubscribeEvents:
+            return R"({"status": "error", "code": 400, "message": "SUBSCRIBE_EVENTS requires a text connection"})";
+        // UPLOAD, GET_IMAGE, PROTO 는 연결 계층에서만
+        default: return R"({"status": "error", "code": 400, "message": "Unknown command"})";
+    }
+}
+bool CommandHandler::isReadOnly(std::string_view commandStr) {
+    const CommandInfo* info = findCommand(commandStr);
+    return info && info->readOnly;
 }
+
 void CommandHandler::handleGetImage(SSL* ssl, const std::string& imagePath) {
     imageHandler_->handleGetImage(ssl, imagePath);
 }
 
-std::string CommandHandler::handleRegister(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email, password;
-    iss >> email >> password;
+std::string CommandHandler::handleRegister(std::string_view payload) {
+    std::string_view email, password;
 
-    if (email.empty() || password.empty()) { // 이메일 또는 비밀번호가 비어있는 경우
+    if (!parseArgs(payload, 2, email, password)) { // 이메일 또는 비밀번호가 비어있는 경우
         return R"({"status": "error", "code": 400, "message": "Email or password is missing"})";
     }
 
@@ -52,7 +333,7 @@ std::string CommandHandler::handleRegister(const std::string& payload) {
 
     // 비밀번호 해싱 (SHA-256)
     unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(reinterpret_cast<const unsigned char*>(password.c_str()), password.size(), hash);
+    SHA256(reinterpret_cast<const unsigned char*>(password.data()), password.size(), hash);
 
     std::stringstream ss;
     for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
@@ -79,12 +360,10 @@ std::string CommandHandler::handleRegister(const std::string& payload) {
     return R"({"status": "success", "code": 200, "message": "User registered successfully"})";
 }
 
-std::string CommandHandler::handleLogin(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email, password;
-    iss >> email >> password;
+std::string CommandHandler::handleLogin(std::string_view payload) {
+    std::string_view email, password;
 
-    if (email.empty() || password.empty()) { // 이메일 또는 비밀번호가 비어있는 경우
+    if (!parseArgs(payload, 2, email, password)) { // 이메일 또는 비밀번호가 비어있는 경우
         return R"({"status": "error", "code": 400, "message": "Email or password is missing"})";
     }
 
@@ -96,7 +375,7 @@ std::string CommandHandler::handleLogin(const std::string& payload) {
 
     // 사용자가 입력한 비밀번호를 SHA-256으로 해싱
     unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(reinterpret_cast<const unsigned char*>(password.c_str()), password.size(), hash);
+    SHA256(reinterpret_cast<const unsigned char*>(password.data()), password.size(), hash);
 
     std::stringstream ss;
     for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
@@ -114,12 +393,10 @@ std::string CommandHandler::handleLogin(const std::string& payload) {
     return R"({"status": "success", "code": 200, "message": "Login successful"})";
 }
 
-std::string CommandHandler::handleResetPassword(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email, newPassword;
-    iss >> email >> newPassword;
+std::string CommandHandler::handleResetPassword(std::string_view payload) {
+    std::string_view email, newPassword;
 
-    if (email.empty() || newPassword.empty()) { // 이메일 또는 비밀번호가 비어있는 경우
+    if (!parseArgs(payload, 2, email, newPassword)) { // 이메일 또는 비밀번호가 비어있는 경우
         return R"({"status": "error", "code": 400, "message": "Email or password is missing"})";
     }
 
@@ -131,7 +408,7 @@ std::string CommandHandler::handleResetPassword(const std::string& payload) {
 
     // 사용자가 입력한 새비밀번호를 SHA-256으로 해싱
     unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256(reinterpret_cast<const unsigned char*>(newPassword.c_str()), newPassword.size(), hash);
+    SHA256(reinterpret_cast<const unsigned char*>(newPassword.data()), newPassword.size(), hash);
 
     std::stringstream ss;
     for (int i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
@@ -149,326 +426,360 @@ std::string CommandHandler::handleResetPassword(const std::string& payload) {
     return R"({"status": "success", "code": 200, "message": "Password reset successful"})";
 }
 
-std::string CommandHandler::handleGetHistory(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email;
+std::string CommandHandler::handleGetHistory(std::string_view payload) {
+    std::string_view email;
     int limit = 10; // 기본값
     int offset = 0; // 기본값
 
-    iss >> email >> limit >> offset;
-
-    if (email.empty() || limit <= 0 || offset < 0) {
+    if (!parseArgs(payload, 1, email, limit, offset) || limit <= 0 || offset < 0) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    auto userOpt = userRepo.getUserByEmail(email);
-    if (!userOpt.has_value()) {
-        return R"({"status": "error", "code": 404, "message": "User not found"})";
+    return historyResponse(writeHistoryRow, [&](const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistories(limit, offset, visit);
+    });
+}
+
+
+std::string CommandHandler::handleAddHistory(std::string_view payload) {
+    History newHistory;
+    if (!parseHistory(payload, newHistory)) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    auto history = historyRepo.getHistories(limit, offset);
+    if (!historyRepo.createHistory(newHistory)) {
+        return R"({"status": "error", "code": 500, "message": "Failed to create history"})";
+    }
 
-    nlohmann::json data = nlohmann::json::array();
-    for (const auto& h : history) {
-        std::string start_snapshot, end_snapshot;
-        nlohmann::json speed_json;
+    return R"({"status": "success", "code": 200, "message": "History created successfully"})";
+}
 
-        if (h.eventType == 0) { // 불법주정차
-            start_snapshot = h.startSnapshot;
-            end_snapshot = h.endSnapshot;
-            speed_json = nullptr;
-        } else if (h.eventType == 1) { // 과속
-    start_snapshot = "";
-    end_snapshot = "";
-    if (h.speed.has_value()) {
-        float rounded = std::round(h.speed.value() * 100) / 100.0f;
-        speed_json = rounded;
+// 여러 건을 트랜잭션 하나로. 인자는 JSON 배열 한 줄이거나 (텍스트 연결),
+// ADD_HISTORY 인자 형식의 줄 여러 개 (바이너리 프레임). 건별 결과를 요청 순서대로 돌려준다
+std::string CommandHandler::handleAddHistoryBatch(std::string_view payload) {
+    constexpr size_t kMaxRecords = 1000;
+
+    std::vector<History> records;
+    std::vector<bool> valid; // 건별 형식 검사 결과
+    size_t start = payload.find_first_not_of(" \t\r\n");
+    if (start != std::string_view::npos && payload[start] == '[') {
+        ArenaJson array = ArenaJson::parse(payload.substr(start), nullptr, false);
+        if (array.is_discarded() || !array.is_array()) {
+            return R"({"status": "error", "code": 400, "message": "Invalid JSON array"})";
+        }
+        if (array.size() > kMaxRecords) {
+            return R"({"status": "error", "code": 413, "message": "Too many records"})";
+        }
+        for (const ArenaJson& item : array) {
+            valid.push_back(parseHistory(item, records.emplace_back()));
+        }
     } else {
-        speed_json = nullptr;
-    }
-} else { // 어린이 감지 등 기타
-            start_snapshot = "";
-            end_snapshot = "";
-            speed_json = nullptr;
+        size_t pos = 0;
+        while (pos < payload.size()) {
+            size_t end = payload.find('\n', pos);
+            if (end == std::string_view::npos) end = payload.size();
+            std::string_view record = payload.substr(pos, end - pos);
+            pos = end + 1;
+            if (ArgReader(record).done()) continue; // 빈 줄
+            if (records.size() == kMaxRecords) {
+                return R"({"status": "error", "code": 413, "message": "Too many records"})";
+            }
+            valid.push_back(parseHistory(record, records.emplace_back()));
         }
-
-        data.push_back({
-            {"id", h.id},
-            {"date", h.date},
-            {"image_path", h.imagePath},
-            {"plate_number", h.plateNumber},
-            {"event_type", h.eventType},
-            {"start_snapshot", start_snapshot},
-            {"end_snapshot", end_snapshot},
-            {"speed", speed_json}
-        });
     }
-
-    nlohmann::json response = {
-        {"status", "success"},
-        {"code", 200},
-        {"message", "History retrieved successfully"},
-        {"data", data}
-    };
-    return response.dump();
+    if (records.empty()) {
+        return R"({"status": "error", "code": 400, "message": "No records"})";
+    }
+
+    // 형식이 맞는 건만 한 트랜잭션으로
+    std::vector<History> accepted;
+    accepted.reserve(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (valid[i]) accepted.push_back(std::move(records[i]));
+    }
+    std::vector<int> ids;
+    if (!historyRepo.createHistories(accepted, ids)) {
+        return R"({"status": "error", "code": 500, "message": "Failed to commit batch"})";
+    }
+
+    std::string out;
+    JsonWriter json(out);
+    size_t inserted = 0;
+    json.beginObject();
+    json.key("code"); json.value(200);
+    json.key("data");
+    json.beginArray();
+    for (size_t i = 0, next = 0; i < records.size(); ++i) {
+        int id = valid[i] ? ids[next++] : -1;
+        json.beginObject();
+        if (id >= 0) {
+            json.key("id");      json.value(id);
+            json.key("status");  json.value("success");
+            ++inserted;
+        } else {
+            json.key("message"); json.value(valid[i] ? "Failed to create history" : "Invalid input format");
+            json.key("status");  json.value("error");
+        }
+        json.endObject();
+    }
+    json.endArray();
+    json.key("failed");   json.value(static_cast<int64_t>(records.size() - inserted));
+    json.key("inserted"); json.value(static_cast<int64_t>(inserted));
+    json.key("message");  json.value("Batch processed");
+    json.key("status");   json.value("success");
+    json.endObject();
+    return out;
 }
 
 
-std::string CommandHandler::handleAddHistory(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string rawDate, imagePath, plateNumber, startSnapshot, endSnapshot;
-    int eventType;
-    float speed = -1;
-    iss >> rawDate >> imagePath >> plateNumber >> eventType >> startSnapshot >> endSnapshot >> speed;
 
+std::string CommandHandler::handleGetHistoryByEventType(std::string_view payload) {
+    std::string_view email;
+    int eventType = 0;
+    int limit = 10;
+    int offset = 0;
 
-    if (rawDate.empty() || imagePath.empty() || plateNumber.empty() || eventType < 0 || eventType > 2) {
+    if (!parseArgs(payload, 2, email, eventType, limit, offset) || eventType < 0 || limit <= 0 || offset < 0) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    // 날짜 형식 변경: YYYY-MM-DD_HH:MM:SS → YYYY-MM-DD HH:MM:SS
-    std::replace(rawDate.begin(), rawDate.end(), '_', ' ');
+    return historyResponse(writeTypedHistoryRow, [&](const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByEventType(eventType, limit, offset, visit);
+    });
+}
 
-    History newHistory;
-    newHistory.date = rawDate;
-    newHistory.imagePath = imagePath;
-    newHistory.plateNumber = plateNumber;
-    newHistory.eventType = eventType;
-    newHistory.startSnapshot = startSnapshot;
-    newHistory.endSnapshot = endSnapshot;
-    if (eventType == 1 && speed >= 0) // 속도위반일 때만
-        newHistory.speed = speed;
-    else
-        newHistory.speed = std::nullopt;
 
-    if (!historyRepo.createHistory(newHistory)) {
-        return R"({"status": "error", "code": 500, "message": "Failed to create history"})";
-    }
 
-    return R"({"status": "success", "code": 200, "message": "History created successfully"})";
-}
 
 
-
-std::string CommandHandler::handleGetHistoryByEventType(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email;
-    int eventType = 0;
+std::string CommandHandler::handleGetHistoryByDateRange(std::string_view payload) {
+    std::string_view email;
+    DateArg startDateRaw, endDateRaw;
     int limit = 10;
     int offset = 0;
 
-    iss >> email >> eventType >> limit >> offset;
-
-    if (email.empty() || eventType < 0 || limit <= 0 || offset < 0) {
+    if (!parseArgs(payload, 3, email, startDateRaw, endDateRaw, limit, offset) || limit <= 0 || offset < 0) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    auto userOpt = userRepo.getUserByEmail(email);
-    if (!userOpt.has_value()) {
-        return R"({"status": "error", "code": 404, "message": "User not found"})";
-    }
+    ArenaString startDate = ArenaString(startDateRaw.value) + " 00:00:00";
+    ArenaString endDate = ArenaString(endDateRaw.value) + " 23:59:59";
 
-    auto history = historyRepo.getHistoriesByEventType(eventType, limit, offset);
-
-    nlohmann::json data = nlohmann::json::array();
-    for (const auto& h : history) {
-        if (h.eventType == 0) { // 불법주정차
-            data.push_back({
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"plate_number", h.plateNumber},
-                {"event_type", h.eventType},
-                {"start_snapshot", h.startSnapshot},
-                {"end_snapshot", h.endSnapshot}
-                // speed 없음
-            });
-        } else if (h.eventType == 1) { // 과속
-            nlohmann::json obj = {
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"plate_number", h.plateNumber},
-                {"event_type", h.eventType}
-                // start_snapshot, end_snapshot 없음
-            };
-            if (h.speed.has_value()) {
-                float rounded = std::round(h.speed.value() * 100) / 100.0f;
-                obj["speed"] = rounded;
-            }
-            data.push_back(obj);
-        } else if (h.eventType == 2) { // 어린이 감지
-            data.push_back({
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"event_type", h.eventType}
-                // speed, start_snapshot, end_snapshot, plate_number 없음
-            });
-        }
-    }
-
-    nlohmann::json response = {
-        {"status", "success"},
-        {"code", 200},
-        {"message", "History retrieved successfully"},
-        {"data", data}
-    };
-    return response.dump();
+    return historyResponse(writeHistoryRow, [&](const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByDateRange(startDate, endDate, limit, offset, visit);
+    });
 }
 
 
 
-
-
-std::string CommandHandler::handleGetHistoryByDateRange(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email, startDateRaw, endDateRaw;
+std::string CommandHandler::handleGetHistoryByEventTypeAndDateRange(std::string_view payload) {
+    std::string_view email;
+    DateArg startDateRaw, endDateRaw;
+    int eventType = 0;
     int limit = 10;
     int offset = 0;
 
-    iss >> email >> startDateRaw >> endDateRaw >> limit >> offset;
-
-    std::string startDate = startDateRaw + " 00:00:00";
-    std::string endDate = endDateRaw + " 23:59:59";
-
-    if (email.empty() || startDateRaw.empty() || endDateRaw.empty() || limit <= 0 || offset < 0) {
+    if (!parseArgs(payload, 4, email, eventType, startDateRaw, endDateRaw, limit, offset) ||
+        eventType < 0 || limit <= 0 || offset < 0) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    auto userOpt = userRepo.getUserByEmail(email);
-    if (!userOpt.has_value()) {
-        return R"({"status": "error", "code": 404, "message": "User not found"})";
-    }
+    ArenaString startDate = ArenaString(startDateRaw.value) + " 00:00:00";
+    ArenaString endDate = ArenaString(endDateRaw.value) + " 23:59:59";
 
-    auto histories = historyRepo.getHistoriesByDateRange(startDate, endDate, limit, offset);
+    return historyResponse(writeTypedHistoryRow, [&](const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByEventTypeAndDateRange(eventType, startDate, endDate, limit, offset, visit);
+    });
+}
 
-    nlohmann::json data = nlohmann::json::array();
-    for (const auto& h : histories) {
-        std::string start_snapshot, end_snapshot;
-        nlohmann::json speed_json;
 
-        if (h.eventType == 0) { // 불법주정차
-            start_snapshot = h.startSnapshot;
-            end_snapshot = h.endSnapshot;
-            speed_json = nullptr;
-        } else if (h.eventType == 1) { // 과속
-    start_snapshot = "";
-    end_snapshot = "";
-    if (h.speed.has_value()) {
-        float rounded = std::round(h.speed.value() * 100) / 100.0f;
-        speed_json = rounded;
-    } else {
-        speed_json = nullptr;
-    }
-} else { // 기타(어린이감지)
-            start_snapshot = "";
-            end_snapshot = "";
-            speed_json = nullptr;
-        }
+// 기간·유형별 건수: GET_STATS email start end [day|hour]. 같은 기간의 유형들을 한 원소로 묶는다
+// {"counts":{"<유형>":건수,...},"period":...,"total":합계}
+std::string CommandHandler::handleGetStats(std::string_view payload) {
+    std::string_view email, unit = "day";
+    DateArg startDate, endDate;
 
-        data.push_back({
-            {"id", h.id},
-            {"date", h.date},
-            {"image_path", h.imagePath},
-            {"plate_number", h.plateNumber},
-            {"event_type", h.eventType},
-            {"start_snapshot", start_snapshot},
-            {"end_snapshot", end_snapshot},
-            {"speed", speed_json}
-        });
+    if (!parseArgs(payload, 3, email, startDate, endDate, unit) || (unit != "day" && unit != "hour")) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
-    nlohmann::json response = {
-        {"status", "success"},
-        {"code", 200},
-        {"message", "History retrieved successfully"},
-        {"data", data}
+    std::string out;
+    JsonWriter json(out);
+    bool open = false;   // 기간 원소를 쓰는 중인지
+    std::string period;  // 지금 쓰고 있는 원소의 기간 (SQLite 버퍼는 다음 행에서 바뀌므로 복사)
+    long long total = 0;
+    auto closePeriod = [&] {
+        json.endObject();
+        json.key("period");  json.value(period);
+        json.key("total");   json.value(static_cast<int64_t>(total));
+        json.endObject();
+        open = false;
     };
 
-    return response.dump();
+    json.beginObject();
+    json.key("code");        json.value(200);
+    json.key("data");
+    json.beginArray();
+    bool ok = historyRepo.getStats(startDate.value, endDate.value, unit == "hour", [&](const HistoryStatsRow& row) {
+        if (open && row.period != period) closePeriod();
+        if (!open) {
+            period.assign(row.period);
+            total = 0;
+            json.beginObject();
+            json.key("counts");
+            json.beginObject();
+            open = true;
+        }
+        json.key(std::to_string(row.eventType));
+        json.value(static_cast<int64_t>(row.count));
+        total += row.count;
+        return json.ok();
+    });
+    if (open) closePeriod();
+    json.endArray();
+    json.key("message");     json.value("Stats retrieved successfully");
+    json.key("status");      json.value("success");
+    json.endObject();
+
+    if (!ok || !json.ok()) {
+        return R"({"status": "error", "code": 500, "message": "Failed to read stats"})";
+    }
+    return out;
 }
 
+// 키셋 페이지 변형: 인자 끝의 cursor (이전 응답의 next_cursor) 다음부터. 생략하면 첫 페이지
+std::string CommandHandler::handleGetHistoryPage(std::string_view payload) {
+    std::string_view email, cursorToken;
+    int limit = 10;
+    std::string cursorDate;
+    HistoryCursor cursor;
 
+    if (!parseArgs(payload, 1, email, limit, cursorToken) || limit <= 0 ||
+        (!cursorToken.empty() && !parseCursor(cursorToken, cursorDate, cursor.id))) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
+    cursor.date = cursorDate;
+    const HistoryCursor* after = cursorToken.empty() ? nullptr : &cursor;
+
+    return historyPageResponse(writeHistoryRow, limit, [&](int rows, const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesPage(after, rows, visit);
+    });
+}
 
-std::string CommandHandler::handleGetHistoryByEventTypeAndDateRange(const std::string& payload) {
-    std::istringstream iss(payload);
-    std::string email, startDateRaw, endDateRaw;
+std::string CommandHandler::handleGetHistoryByEventTypePage(std::string_view payload) {
+    std::string_view email, cursorToken;
     int eventType = 0;
     int limit = 10;
-    int offset = 0;
+    std::string cursorDate;
+    HistoryCursor cursor;
 
-    iss >> email >> eventType >> startDateRaw >> endDateRaw >> limit >> offset;
+    if (!parseArgs(payload, 2, email, eventType, limit, cursorToken) || eventType < 0 || limit <= 0 ||
+        (!cursorToken.empty() && !parseCursor(cursorToken, cursorDate, cursor.id))) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
+    cursor.date = cursorDate;
+    const HistoryCursor* after = cursorToken.empty() ? nullptr : &cursor;
+
+    return historyPageResponse(writeTypedHistoryRow, limit, [&](int rows, const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByEventTypePage(eventType, after, rows, visit);
+    });
+}
 
-    std::string startDate = startDateRaw + " 00:00:00";
-    std::string endDate = endDateRaw + " 23:59:59";
+std::string CommandHandler::handleGetHistoryByDateRangePage(std::string_view payload) {
+    std::string_view email, cursorToken;
+    DateArg startDateRaw, endDateRaw;
+    int limit = 10;
+    std::string cursorDate;
+    HistoryCursor cursor;
 
-    if (email.empty() || startDateRaw.empty() || endDateRaw.empty() || eventType < 0 || limit <= 0 || offset < 0) {
+    if (!parseArgs(payload, 3, email, startDateRaw, endDateRaw, limit, cursorToken) || limit <= 0 ||
+        (!cursorToken.empty() && !parseCursor(cursorToken, cursorDate, cursor.id))) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
+    cursor.date = cursorDate;
+    const HistoryCursor* after = cursorToken.empty() ? nullptr : &cursor;
 
-    auto userOpt = userRepo.getUserByEmail(email);
-    if (!userOpt.has_value()) {
-        return R"({"status": "error", "code": 404, "message": "User not found"})";
-    }
+    ArenaString startDate = ArenaString(startDateRaw.value) + " 00:00:00";
+    ArenaString endDate = ArenaString(endDateRaw.value) + " 23:59:59";
+    return historyPageResponse(writeHistoryRow, limit, [&](int rows, const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByDateRangePage(startDate, endDate, after, rows, visit);
+    });
+}
 
-    auto histories = historyRepo.getHistoriesByEventTypeAndDateRange(eventType, startDate, endDate, limit, offset);
-
-    nlohmann::json data = nlohmann::json::array();
-    for (const auto& h : histories) {
-        if (h.eventType == 0) { // 불법주정차
-            data.push_back({
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"plate_number", h.plateNumber},
-                {"event_type", h.eventType},
-                {"start_snapshot", h.startSnapshot},
-                {"end_snapshot", h.endSnapshot}
-                // speed 없음
-            });
-        } else if (h.eventType == 1) { // 과속
-            nlohmann::json obj = {
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"plate_number", h.plateNumber},
-                {"event_type", h.eventType}
-                // start_snapshot, end_snapshot 없음
-            };
-            if (h.speed.has_value()) {
-                float rounded = std::round(h.speed.value() * 100) / 100.0f;
-                obj["speed"] = rounded;
-            }
-            data.push_back(obj);
-        } else if (h.eventType == 2) { // 어린이 감지
-            data.push_back({
-                {"id", h.id},
-                {"date", h.date},
-                {"image_path", h.imagePath},
-                {"event_type", h.eventType}
-                // plate_number, speed, start_snapshot, end_snapshot 없음
-            });
-        }
+std::string CommandHandler::handleGetHistoryByEventTypeAndDateRangePage(std::string_view payload) {
+    std::string_view email, cursorToken;
+    DateArg startDateRaw, endDateRaw;
+    int eventType = 0;
+    int limit = 10;
+    std::string cursorDate;
+    HistoryCursor cursor;
+
+    if (!parseArgs(payload, 4, email, eventType, startDateRaw, endDateRaw, limit, cursorToken) ||
+        eventType < 0 || limit <= 0 ||
+        (!cursorToken.empty() && !parseCursor(cursorToken, cursorDate, cursor.id))) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
+    cursor.date = cursorDate;
+    const HistoryCursor* after = cursorToken.empty() ? nullptr : &cursor;
 
-    nlohmann::json response = {
-        {"status", "success"},
-        {"code", 200},
-        {"message", "History retrieved successfully"},
-        {"data", data}
-    };
+    ArenaString startDate = ArenaString(startDateRaw.value) + " 00:00:00";
+    ArenaString endDate = ArenaString(endDateRaw.value) + " 23:59:59";
+    return historyPageResponse(writeTypedHistoryRow, limit, [&](int rows, const HistoryRepository::RowVisitor& visit) {
+        return historyRepo.getHistoriesByEventTypeAndDateRangePage(eventType, startDate, endDate, after, rows, visit);
+    });
+}
+
+
+// 변경 피드: 클라이언트가 마지막으로 받은 id 이후의 행만 id 순으로 돌려주고 다음 커서를 함께 준다.
+// 페이지를 처음부터 다시 받지 않으므로 비용은 새 행 수에 비례
+std::string CommandHandler::handleGetHistorySince(std::string_view payload) {
+    int lastId = -1;
+    int limit = 100; // 기본값
 
-    return response.dump();
+    // 커서가 숫자가 아니면 처음부터 보내게 되므로 형식 오류로 거절한다
+    if (!parseArgs(payload, 1, lastId, limit) || lastId < 0 || limit <= 0) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
+
+    // 응답 키 순서상 cursor 가 data 앞이라 행은 따로 쓰고 붙인다
+    std::string rows;
+    JsonWriter rowsJson(rows);
+    int cursor = lastId; // 새 행이 없으면 커서는 그대로
+    int count = 0;
+    rowsJson.beginArray();
+    bool read = historyRepo.getHistoriesSince(lastId, limit, [&](const HistoryRow& h) {
+        writeHistoryRow(rowsJson, h);
+        cursor = h.id;
+        ++count;
+        return rowsJson.ok();
+    });
+    // 일부만 읽고 실패했는데 cursor·has_more 를 보내면 클라이언트가 못 받은 행을 건너뛴다
+    if (!read) return kHistoryReadFailed;
+    rowsJson.endArray();
+    if (!rowsJson.ok()) {
+        return R"({"status": "error", "code": 500, "message": "Invalid UTF-8 in history record"})";
+    }
+
+    // limit 만큼 찼으면 뒤에 더 있을 수 있다
+    std::string out;
+    JsonWriter json(out);
+    json.beginObject();
+    json.key("code");     json.value(200);
+    json.key("cursor");   json.value(cursor);
+    json.key("data");     json.raw(rows);
+    json.key("has_more"); json.value(count == limit);
+    json.key("message");  json.value("History retrieved successfully");
+    json.key("status");   json.value("success");
+    json.endObject();
+    return out;
 }
 
 
-std::string CommandHandler::handleChangeFrame(const std::string& payload) {
-    std::istringstream iss(payload);
+std::string CommandHandler::handleChangeFrame(std::string_view payload) {
+    ArgReader reader(payload);
     int menu_type;
 
-    iss >> menu_type;
-    if (iss.fail()) {
+    if (!reader.read(menu_type)) {
         return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
     }
 
@@ -479,7 +790,7 @@ std::string CommandHandler::handleChangeFrame(const std::string& payload) {
     if (!ifs.is_open()) {
         return R"({"status": "error", "code": 500, "message": "Failed to open overlay_config"})";
     }
-    nlohmann::json config;
+    ArenaJson config;
     try {
         ifs >> config;
     } catch (...) {
@@ -488,8 +799,7 @@ std::string CommandHandler::handleChangeFrame(const std::string& payload) {
 
     if (menu_type == 0 || menu_type == 1) {
         int bool_val;
-        iss >> bool_val;
-        if (iss.fail() || (bool_val != 0 && bool_val != 1)) {
+        if (!reader.read(bool_val) || !reader.done() || (bool_val != 0 && bool_val != 1)) {
             return R"({"status": "error", "code": 400, "message": "Invalid boolean value"})";
         }
         if (menu_type == 0) {
@@ -498,10 +808,9 @@ std::string CommandHandler::handleChangeFrame(const std::string& payload) {
             config["show_timestamp"] = static_cast<bool>(bool_val);
         }
     } else if (menu_type == 2) {
-        std::string mode_val;
-        iss >> mode_val;
+        std::string_view mode_val;
 
-        if (iss.fail() || (mode_val != "original" && mode_val != "sharp" &&
+        if (!reader.read(mode_val) || (mode_val != "original" && mode_val != "sharp" &&
                         mode_val != "day" && mode_val != "night")) {
             return R"json({"status": "error", "code": 400, "message": "Invalid mode value"})json";
         }
@@ -510,12 +819,14 @@ std::string CommandHandler::handleChangeFrame(const std::string& payload) {
 
         if (mode_val == "sharp") {
             int sharpness_val;
-            iss >> sharpness_val;
-            if (iss.fail() || sharpness_val < 0 || sharpness_val > 100) {
+            if (!reader.read(sharpness_val) || !reader.done() || sharpness_val < 0 || sharpness_val > 100) {
                 return R"json({"status": "error", "code": 400, "message": "Invalid sharpness level (0~100)"})json";
             }
             config["sharpness_level"] = sharpness_val;
         } else {
+            if (!reader.done()) {
+                return R"json({"status": "error", "code": 400, "message": "Invalid mode value"})json";
+            }
             config.erase("sharpness_level");
         }
     } else {
@@ -535,9 +846,12 @@ std::string CommandHandler::handleChangeFrame(const std::string& payload) {
 
 
 
-std::string CommandHandler::handleGetFrame(const std::string& payload) {
+std::string CommandHandler::handleGetFrame(std::string_view payload) {
+    if (!parseArgs(payload, 0)) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
     const std::string config_path = "/dev/shm/overlay_config";
-    nlohmann::json config;
+    ArenaJson config;
 
     // 파일 읽기
     std::ifstream ifs(config_path);
@@ -550,18 +864,21 @@ std::string CommandHandler::handleGetFrame(const std::string& payload) {
         return R"({"status": "error", "code": 500, "message": "Failed to parse overlay_config"})";
     }
 
-    nlohmann::json response = {
+    ArenaJson response = {
         {"status", "success"},
         {"code", 200},
         {"message", "Overlay config retrieved"},
         {"data", config}
     };
-    return response.dump();
+    return toResponse(response);
 }
 
-std::string CommandHandler::handleGetLog(const std::string& payload) {
+std::string CommandHandler::handleGetLog(std::string_view payload) {
+    if (!parseArgs(payload, 0)) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
     const std::string config_path = "/dev/shm/shm_status";
-    nlohmann::json config;
+    ArenaJson config;
 
     // 파일 읽기
     std::ifstream ifs(config_path);
@@ -574,11 +891,24 @@ std::string CommandHandler::handleGetLog(const std::string& payload) {
         return R"({"status": "error", "code": 500, "message": "Failed to parse shm_status"})";
     }
 
-    nlohmann::json response = {
+    ArenaJson response = {
         {"status", "success"},
         {"code", 200},
         {"message", "shm_status retrieved"},
         {"data", config}
     };
-    return response.dump();
+    return toResponse(response);
+}
+
+std::string CommandHandler::handleGetMetrics(std::string_view payload) {
+    if (!parseArgs(payload, 0)) {
+        return R"({"status": "error", "code": 400, "message": "Invalid input format"})";
+    }
+    ArenaJson response = {
+        {"status", "success"},
+        {"code", 200},
+        {"message", "Server metrics retrieved"},
+        {"data", ArenaJson::parse(serverMetrics().toJson())}
+    };
+    return toResponse(response);
 }
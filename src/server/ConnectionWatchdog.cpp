@@ -0,0 +1,113 @@
+// src/server/ConnectionWatchdog.cpp
+
+#include <sys/socket.h>
+#include <vector>
+
+#include "server/ConnectionWatchdog.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/Logger.hpp"
+
+const char* timeoutName(TimeoutKind kind) {
+    switch (kind) {
+        case TimeoutKind::Handshake: return "handshake";
+        case TimeoutKind::Idle:      return "idle";
+        case TimeoutKind::Header:    return "header";
+        case TimeoutKind::Upload:    return "upload";
+        default:                     return "none";
+    }
+}
+
+void countTimeout(TimeoutKind kind) {
+    ServerMetrics& m = serverMetrics();
+    switch (kind) {
+        case TimeoutKind::Handshake: m.handshakesTimedOut++; break;
+        case TimeoutKind::Idle:      m.idleTimeouts++;       break;
+        case TimeoutKind::Header:    m.headerTimeouts++;     break;
+        case TimeoutKind::Upload:    m.uploadTimeouts++;     break;
+        default: break;
+    }
+}
+
+bool bytesPending(int fd) {
+    char c;
+    return recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) > 0;
+}
+
+ConnectionWatchdog::ConnectionWatchdog()
+  : stopping(false), wheel(kTimerTick, kTimerSlots) {
+    thread = std::thread([this] { run(); });
+}
+
+ConnectionWatchdog::~ConnectionWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    thread.join();
+}
+
+void ConnectionWatchdog::arm(int fd, TimeoutKind kind, int timeoutMs, bool betweenRequest) {
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (betweenRequest) {
+            betweenRequests.insert(fd);
+            // 드레인 중에는 새 명령을 받지 않는다
+            if (draining && !bytesPending(fd)) shutdown(fd, SHUT_RDWR);
+        } else {
+            betweenRequests.erase(fd);
+        }
+        if (timeoutMs <= 0) {
+            wheel.cancel(fd);
+            watched.erase(fd);
+            return;
+        }
+        wasEmpty = wheel.empty();
+        wheel.schedule(fd, TimerWheel::Clock::now() + std::chrono::milliseconds(timeoutMs));
+        watched[fd] = kind;
+    }
+    // 감시 대상이 없어 무기한 대기 중이던 스레드를 깨운다
+    if (wasEmpty) cv.notify_one();
+}
+
+void ConnectionWatchdog::disarm(int fd) {
+    std::lock_guard<std::mutex> lock(mtx);
+    wheel.cancel(fd);
+    watched.erase(fd);
+    betweenRequests.erase(fd);
+}
+
+void ConnectionWatchdog::drain() {
+    std::lock_guard<std::mutex> lock(mtx);
+    draining = true;
+    // 연결 스레드의 SSL_read 가 0 으로 돌아와 평소처럼 정리한다
+    for (int fd : betweenRequests) {
+        if (!bytesPending(fd)) shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void ConnectionWatchdog::run() {
+    std::vector<uint64_t> expired;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!stopping) {
+        if (wheel.empty()) {
+            cv.wait(lock);
+        } else {
+            int wait = wheel.nextTimeoutMs(TimerWheel::Clock::now());
+            cv.wait_for(lock, std::chrono::milliseconds(wait));
+        }
+
+        expired.clear();
+        wheel.advance(TimerWheel::Clock::now(), expired);
+        for (uint64_t id : expired) {
+            int fd = static_cast<int>(id);
+            TimeoutKind kind = watched[fd];
+            watched.erase(fd);
+            LOG_WARN("[TcpServer] ", timeoutName(kind), " timeout, closing fd=", fd);
+            countTimeout(kind);
+            // 연결 스레드의 SSL_read/SSL_write 가 실패로 돌아와 정리한다
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+}
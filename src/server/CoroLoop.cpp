@@ -0,0 +1,800 @@
+// src/server/CoroLoop.cpp
+
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "server/CoroLoop.hpp"
+#include "server/TcpServer.hpp"
+#include "server/CommandHandler.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/CommandTable.hpp"
+#include "server/EventBroadcaster.hpp"
+#include "server/Frame.hpp"
+#include "server/ImageHandler.hpp"
+#include "server/RecordWriter.hpp"
+#include "server/ServerMetrics.hpp"
+#include "server/WorkerPool.hpp"
+#include "server/TlsSessionCache.hpp"
+#include "util/EndianUtils.hpp"
+#include "util/Logger.hpp"
+
+// main.cpp 에서 초기화된 commandHandler
+extern CommandHandler* commandHandler;
+
+namespace {
+constexpr int kMaxEvents = 64;
+}
+
+CoroLoop::CoroLoop(TcpServer* server, int index)
+  : server(server), index(index), epfd(-1), wakeFd(-1), listenFd(-1), draining(false), nextId(2),
+    timers(kTimerTick, kTimerSlots) {
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        logErrno("epoll_create1");
+        exit(EXIT_FAILURE);
+    }
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        logErrno("eventfd");
+        exit(EXIT_FAILURE);
+    }
+    epoll_event ev{};
+    ev.events   = EPOLLIN;
+    ev.data.u64 = kWakeupId;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+CoroLoop::~CoroLoop() {
+    close(wakeFd);
+    close(epfd);
+}
+
+void CoroLoop::addListener(int listen_fd, bool shared) {
+    listenFd = listen_fd;
+    int flags = fcntl(listenFd, F_GETFL, 0);
+    fcntl(listenFd, F_SETFL, flags | O_NONBLOCK);
+
+    epoll_event ev{};
+    // 같은 소켓을 여러 루프가 기다릴 때 연결 하나에 루프 하나만 깨운다
+    ev.events   = shared ? (EPOLLIN | EPOLLEXCLUSIVE) : EPOLLIN;
+    ev.data.u64 = kListenerId;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listenFd, &ev);
+}
+
+void CoroLoop::drain() {
+    if (listenFd >= 0) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, listenFd, nullptr);
+        listenFd = -1;
+    }
+    draining = true;
+
+    // 다음 명령을 기다리던 코루틴은 읽기 실패로 깨워 평소처럼 닫게 한다
+    std::vector<uint64_t> idle;
+    for (const auto& [id, conn] : conns) {
+        if (conn->served && conn->betweenRequests && conn->waiter && !bytesPending(conn->fd)) {
+            idle.push_back(id);
+        }
+    }
+    for (uint64_t id : idle) {
+        auto it = conns.find(id);
+        if (it == conns.end()) continue;
+        it->second->closing = true;
+        std::exchange(it->second->waiter, nullptr).resume();
+    }
+}
+
+void CoroLoop::post(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(postMtx);
+        posted.push_back(std::move(fn));
+    }
+    uint64_t one = 1;
+    ssize_t r = write(wakeFd, &one, sizeof(one));
+    (void)r;
+}
+
+void CoroLoop::runPosted() {
+    uint64_t cnt;
+    while (read(wakeFd, &cnt, sizeof(cnt)) > 0) {}
+
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(postMtx);
+        tasks.swap(posted);
+    }
+    for (auto& fn : tasks) fn();
+}
+
+void CoroLoop::run() {
+    LOG_INFO("[CoroLoop ", index, "] running");
+    epoll_event events[kMaxEvents];
+
+    while (true) {
+        int n = epoll_wait(epfd, events, kMaxEvents, timers.nextTimeoutMs(TimerWheel::Clock::now()));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            logErrno("epoll_wait");
+            continue;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            uint64_t id = events[i].data.u64;
+            if (id == kListenerId) {
+                acceptAll();
+            } else if (id == kWakeupId) {
+                runPosted();
+            } else {
+                auto it = conns.find(id);
+                if (it == conns.end()) continue;
+                CoroConn& conn = *it->second;
+                if (!conn.waiter) {
+                    // 작업 풀을 기다리는 중: 레벨 트리거가 반복해서 깨우지 않도록 관심 해제
+                    setInterest(conn, 0);
+                    continue;
+                }
+                // 기다리던 코루틴을 이어서 실행 (다음 co_await 또는 종료까지)
+                std::exchange(conn.waiter, nullptr).resume();
+            }
+        }
+
+        expireTimers();
+    }
+}
+
+void CoroLoop::acceptAll() {
+    int batch = server->getConfig().acceptBatch;
+    for (int i = 0; i < batch; ++i) {
+        int client_fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            logErrno("accept4");
+            return;
+        }
+        LOG_INFO("[TcpServer] TCP connection fd=", client_fd);
+        if (!server->admitConnection()) {
+            LOG_WARN("[TcpServer] Connection limit reached, rejecting fd=", client_fd);
+            close(client_fd);
+            continue;
+        }
+        serve(client_fd);
+    }
+}
+
+// 제한 시간이 지난 연결은 I/O 를 실패시켜 코루틴이 스스로 정리하게 한다
+void CoroLoop::expireTimers() {
+    std::vector<uint64_t> expired;
+    timers.advance(TimerWheel::Clock::now(), expired);
+    for (uint64_t id : expired) {
+        auto it = conns.find(id);
+        if (it == conns.end()) continue;
+        CoroConn& conn = *it->second;
+        LOG_WARN("[TcpServer] ", timeoutName(conn.timeout), " timeout, closing fd=", conn.fd);
+        countTimeout(conn.timeout);
+        conn.timedOut = true;
+        // 작업 풀 명령을 기다리는 중이면 결과가 온 뒤 다음 I/O 에서 끝난다
+        if (conn.waiter) std::exchange(conn.waiter, nullptr).resume();
+    }
+}
+
+void CoroLoop::setInterest(CoroConn& conn, uint32_t events) {
+    if (events == conn.events) return;
+    epoll_event ev{};
+    ev.events   = events;
+    ev.data.u64 = conn.id;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, conn.fd, &ev);
+    conn.events = events;
+}
+
+void CoroLoop::arm(CoroConn& conn, TimeoutKind kind, int timeoutMs) {
+    conn.timeout = kind;
+    if (timeoutMs <= 0) {
+        timers.cancel(conn.id);
+        return;
+    }
+    timers.schedule(conn.id, TimerWheel::Clock::now() + std::chrono::milliseconds(timeoutMs));
+}
+
+void CoroLoop::closeConnection(CoroConn& conn) {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, conn.fd, nullptr);
+    timers.cancel(conn.id);
+    if (conn.ssl) {
+        if (conn.handshaken && !conn.timedOut) SSL_shutdown(conn.ssl);
+        SSL_free(conn.ssl);
+        ERR_clear_error();
+    }
+    close(conn.fd);
+    server->releaseConnection();
+    conns.erase(conn.id);
+}
+
+void CoroLoop::IoAwaiter::await_suspend(std::coroutine_handle<> h) {
+    conn.waiter = h;
+    loop->setInterest(conn, events);
+}
+
+CoroLoop::PoolAwaiter::PoolAwaiter(CoroLoop* loop, const std::vector<std::string>& cmds,
+                                   std::vector<std::string>& results)
+  : loop(loop), cmds(cmds), results(results), remaining(0) {
+    results.assign(cmds.size(), std::string());
+}
+
+bool CoroLoop::PoolAwaiter::await_suspend(std::coroutine_handle<> h) {
+    // +1: 제출하는 동안 먼저 끝난 작업이 재개하지 않도록
+    remaining = cmds.size() + 1;
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        bool queued = loop->server->getWorkerPool()->trySubmit([this, i, h] {
+            results[i] = commandHandler->handle(cmds[i]);
+            finishOne(h);
+        });
+        if (!queued) {
+            results[i] = kServerBusyResponse;
+            remaining--;
+        } else if (i > 0) {
+            serverMetrics().jobsPipelined++;
+        }
+    }
+    // 모두 거절됐거나 이미 끝났으면 멈추지 않고 계속
+    return --remaining != 0;
+}
+
+void CoroLoop::PoolAwaiter::finishOne(std::coroutine_handle<> h) {
+    if (--remaining == 0) {
+        loop->post([h] { h.resume(); });
+    }
+}
+
+// ───────────── 전송 계층 ─────────────
+
+Async<bool> CoroLoop::handshake(CoroConn& conn) {
+    ServerMetrics& m = serverMetrics();
+    m.handshakesInFlight++;
+    arm(conn, TimeoutKind::Handshake, server->getConfig().handshakeTimeoutMs);
+
+    while (true) {
+        ERR_clear_error();
+        int ret = SSL_accept(conn.ssl);
+        if (ret == 1) break;
+
+        int err = SSL_get_error(conn.ssl, ret);
+        bool ok = false;
+        if (err == SSL_ERROR_WANT_READ) {
+            ok = co_await waitIo(conn, EPOLLIN);
+        } else if (err == SSL_ERROR_WANT_WRITE) {
+            ok = co_await waitIo(conn, EPOLLOUT);
+        } else {
+            logSslErrors();
+        }
+        if (!ok) {
+            m.handshakesInFlight--;
+            if (!conn.timedOut) m.handshakesFailed++;
+            co_return false;
+        }
+    }
+
+    LOG_INFO("[TcpServer] SSL handshake OK (fd=", conn.fd, ")");
+    m.handshakesInFlight--;
+    m.handshakesCompleted++;
+    TlsSessionCache::recordHandshake(conn.ssl);
+    conn.handshaken = true;
+    co_return true;
+}
+
+// 한 번 이상 SSL_read 해서 in 에 덧붙인다
+Async<bool> CoroLoop::readSome(CoroConn& conn) {
+    // 유휴 연결은 데이터가 올 때까지 수신 버퍼를 잡지 않는다
+    if (conn.in.empty() && SSL_pending(conn.ssl) == 0) {
+        conn.in.release();
+        if (!co_await waitIo(conn, EPOLLIN)) co_return false;
+    }
+
+    while (true) {
+        if (conn.timedOut) co_return false;
+        char* dst = conn.in.prepareWrite();
+        ERR_clear_error();
+        int n = SSL_read(conn.ssl, dst, static_cast<int>(conn.in.writable()));
+        if (n > 0) {
+            conn.in.commit(n);
+            co_return true;
+        }
+
+        int err = SSL_get_error(conn.ssl, n);
+        if (err == SSL_ERROR_WANT_READ) {
+            if (!co_await waitIo(conn, EPOLLIN)) co_return false;
+        } else if (err == SSL_ERROR_WANT_WRITE) {
+            if (!co_await waitIo(conn, EPOLLOUT)) co_return false;
+        } else {
+            if (err != SSL_ERROR_ZERO_RETURN) logSslErrors();
+            co_return false;
+        }
+    }
+}
+
+// '\n' 포함 한 줄. 줄을 받기 시작한 뒤로는 바이트가 와도 제한 시간을 연장하지 않는다
+Async<bool> CoroLoop::readLine(CoroConn& conn, std::string& line) {
+    const ServerConfig& cfg = server->getConfig();
+    size_t lineLen;
+    while ((lineLen = conn.in.findLine()) == 0) {
+        // 처리할 줄이 더 없으면 모아 둔 응답을 보내고 기다린다
+        if (!co_await flushOutput(conn)) co_return false;
+        if (conn.in.size() > ReadBuffer::kMaxLineLength) {
+            LOG_WARN("[TcpServer] Line too long, closing fd=", conn.fd);
+            co_return false;
+        }
+        bool between = conn.in.empty();
+        if (between) {
+            // 드레인 중에는 다음 명령을 받지 않는다
+            if (draining && conn.served && !bytesPending(conn.fd)) co_return false;
+            arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+        } else if (conn.timeout != TimeoutKind::Header) {
+            arm(conn, TimeoutKind::Header, cfg.headerTimeoutMs);
+        }
+        conn.betweenRequests = between;
+        bool ok = co_await readSome(conn);
+        conn.betweenRequests = false;
+        if (!ok) co_return false;
+    }
+    line.assign(conn.in.data(), lineLen);
+    conn.in.consume(lineLen);
+    co_return true;
+}
+
+// in 에 n 바이트 이상 모일 때까지 읽기 (바이너리 프레임)
+Async<bool> CoroLoop::readExact(CoroConn& conn, size_t n) {
+    const ServerConfig& cfg = server->getConfig();
+    while (conn.in.size() < n) {
+        if (!co_await flushOutput(conn)) co_return false;
+        bool between = conn.in.empty();
+        if (between) {
+            // 드레인 중에는 다음 명령을 받지 않는다
+            if (draining && conn.served && !bytesPending(conn.fd)) co_return false;
+            arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+        } else if (conn.timeout != TimeoutKind::Header) {
+            arm(conn, TimeoutKind::Header, cfg.headerTimeoutMs);
+        }
+        conn.betweenRequests = between;
+        bool ok = co_await readSome(conn);
+        conn.betweenRequests = false;
+        if (!ok) co_return false;
+    }
+    co_return true;
+}
+
+Async<bool> CoroLoop::writeAll(CoroConn& conn, std::string_view data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        if (conn.timedOut) co_return false;
+        ERR_clear_error();
+        int n = SSL_write(conn.ssl, data.data() + offset, static_cast<int>(data.size() - offset));
+        if (n > 0) {
+            offset += n;
+            countTlsRecords(n);
+            continue;
+        }
+
+        int err = SSL_get_error(conn.ssl, n);
+        if (err == SSL_ERROR_WANT_WRITE) {
+            if (!co_await waitIo(conn, EPOLLOUT)) co_return false;
+        } else if (err == SSL_ERROR_WANT_READ) {
+            if (!co_await waitIo(conn, EPOLLIN)) co_return false;
+        } else {
+            logSslErrors();
+            co_return false;
+        }
+    }
+    co_return true;
+}
+
+Async<bool> CoroLoop::respond(CoroConn& conn, std::string_view resp) {
+    serverMetrics().responsesSent++;
+    conn.out.append(resp);
+    // 꽉 찬 레코드만 보내고 자투리는 다음 응답과 합친다
+    size_t full = conn.out.size() - conn.out.size() % kTlsRecordSize;
+    if (full == 0) co_return true;
+    if (!co_await writeAll(conn, std::string_view(conn.out).substr(0, full))) co_return false;
+    conn.out.erase(0, full);
+    co_return true;
+}
+
+Async<bool> CoroLoop::flushOutput(CoroConn& conn) {
+    if (conn.out.empty()) co_return true;
+    bool ok = co_await writeAll(conn, conn.out);
+    // 유휴 연결이 송신 버퍼를 잡고 있지 않게
+    std::string().swap(conn.out);
+    co_return ok;
+}
+
+// 이미지 본문 송신. 조각을 보낼 때마다 유휴 제한 시간 연장
+Async<bool> CoroLoop::sendImage(CoroConn& conn, int fd, size_t fileSize, std::string prefix) {
+    int idleMs = server->getConfig().idleTimeoutMs;
+    size_t offset = 0;
+    serverMetrics().responsesSent++;
+
+    bool ktls = ImageHandler::ktlsSendEnabled(conn.ssl);
+    // 본문 조각에 붙일 수 없으면 (kTLS, 빈 파일, 너무 긴 앞부분) 따로 보낸다
+    if (ktls || fileSize == 0 || prefix.size() > ImageHandler::kImageChunk / 2) {
+        if (!co_await writeAll(conn, prefix)) co_return false;
+        prefix.clear();
+    }
+
+    if (ktls) {
+        while (offset < fileSize) {
+            if (conn.timedOut) co_return false;
+            ERR_clear_error();
+            ossl_ssize_t n = SSL_sendfile(conn.ssl, fd, offset, fileSize - offset, 0);
+            if (n > 0) {
+                offset += n;
+                countTlsRecords(n);
+                arm(conn, TimeoutKind::Idle, idleMs);
+                continue;
+            }
+            if (SSL_get_error(conn.ssl, static_cast<int>(n)) != SSL_ERROR_WANT_WRITE) {
+                logSslErrors();
+                co_return false;
+            }
+            if (!co_await waitIo(conn, EPOLLOUT)) co_return false;
+        }
+        serverMetrics().imagesSentKtls++;
+    } else {
+        // 첫 조각은 prefix 뒤에 이어 읽어 꽉 찬 레코드로 보낸다
+        std::string chunk = std::move(prefix);
+        while (offset < fileSize) {
+            size_t pos = chunk.size();
+            chunk.resize(std::min(ImageHandler::kImageChunk, pos + fileSize - offset));
+            ssize_t bytesRead = pread(fd, &chunk[pos], chunk.size() - pos, offset);
+            if (bytesRead <= 0) {
+                // 전송 중 파일이 줄었다: 바이너리 프레임이면 다음 응답이 본문 자리에 읽히므로 연결을 닫는다
+                LOG_WARN("[TcpServer] Image read ended at ", offset, "/", fileSize,
+                         " bytes, closing fd=", conn.fd);
+                serverMetrics().imageBytesSent += offset;
+                co_return false;
+            }
+            chunk.resize(pos + bytesRead);
+            if (!co_await writeAll(conn, chunk)) co_return false;
+            chunk.clear();
+            offset += bytesRead;
+            arm(conn, TimeoutKind::Idle, idleMs);
+        }
+        serverMetrics().imagesSentBuffered++;
+    }
+    serverMetrics().imageBytesSent += offset;
+    co_return true;
+}
+
+Async<bool> CoroLoop::receiveUpload(CoroConn& conn, const std::string& filename, size_t filesize,
+                                    bool drain, std::string& result) {
+    ImageHandler* imageHandler = server->getImageHandler();
+    int uploadMs = server->getConfig().uploadTimeoutMs;
+
+    UploadSession up;
+    result = imageHandler->beginUpload(filename, filesize, up);
+    bool accepted = result.empty();
+    if (!accepted && !drain) co_return true;
+
+    size_t remaining = filesize;
+    while (remaining > 0) {
+        if (conn.in.empty()) {
+            // 본문이 들어올 때마다 연장
+            arm(conn, TimeoutKind::Upload, uploadMs);
+            if (!co_await readSome(conn)) {
+                if (accepted) imageHandler->abortUpload(up);
+                co_return false;
+            }
+        }
+        size_t take = std::min(conn.in.size(), remaining);
+        if (accepted) up.write(conn.in.data(), take);
+        conn.in.consume(take);
+        remaining -= take;
+    }
+    if (accepted) result = imageHandler->finishUpload(up);
+    co_return true;
+}
+
+// ───────────── 연결 흐름 ─────────────
+
+Detached CoroLoop::serve(int client_fd) {
+    CoroConn conn;
+    conn.id  = nextId++;
+    conn.fd  = client_fd;
+    conn.ssl = SSL_new(server->getSslContext());
+    if (!conn.ssl) {
+        logSslErrors();
+        close(client_fd);
+        server->releaseConnection();
+        co_return;
+    }
+    SSL_set_fd(conn.ssl, client_fd);
+    // 유휴 중에는 SSL 레코드 버퍼도 반납
+    SSL_set_mode(conn.ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_RELEASE_BUFFERS);
+    SSL_set_accept_state(conn.ssl);
+
+    conns.emplace(conn.id, &conn);
+    epoll_event ev{};
+    ev.events   = 0;
+    ev.data.u64 = conn.id;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
+        logErrno("epoll_ctl");
+        closeConnection(conn);
+        co_return;
+    }
+
+    if (co_await handshake(conn)) {
+        co_await serveText(conn);
+    }
+    closeConnection(conn);
+}
+
+// 텍스트 프로토콜. 스레드 모드 serveClient 와 같은 흐름. false 면 연결 종료
+Async<bool> CoroLoop::serveText(CoroConn& conn) {
+    const ServerConfig& cfg = server->getConfig();
+    ImageHandler* imageHandler = server->getImageHandler();
+    std::string cmd;
+
+    while (true) {
+        if (!co_await readLine(conn, cmd)) co_return false;
+        if (cmd == "\n") continue;
+        conn.served = true;
+        LOG_INFO("[TcpServer] Received: ", cmd);
+        // 명령 실행과 응답 송신은 유휴 제한 시간 안에
+        arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+        CommandId command = commandId(cmd);
+
+        if (command == CommandId::Upload && imageHandler) {
+            std::string_view filename;
+            size_t filesize = 0;
+            if (!parseArgs(commandArgs(cmd), 2, filename, filesize)) filesize = 0;
+
+            std::string result;
+            if (filename.empty() || filesize == 0) {
+                result = R"({"status":"error","code":400,"message":"Invalid filename or filesize"})";
+            } else if (!co_await flushOutput(conn) ||
+                       !co_await receiveUpload(conn, std::string(filename), filesize, false, result)) {
+                co_return false;
+            }
+            result.push_back('\n');
+            arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+            if (!co_await respond(conn, result)) co_return false;
+
+        } else if (command == CommandId::GetImage && imageHandler) {
+            // 기존 프로토콜: 8바이트 길이 + 본문 후 연결 종료, 에러는 개행 없는 JSON
+            std::string_view imagePath;
+            if (!parseArgs(commandArgs(cmd), 1, imagePath)) imagePath = {};
+
+            size_t fileSize = 0;
+            int fd = imagePath.empty() ? -1 : ImageHandler::openImage(std::string(imagePath), fileSize);
+            if (fd < 0) {
+                co_await respond(conn, imagePath.empty()
+                    ? R"({"status": "error", "code": 400, "message": "Missing image path"})"
+                    : R"({"status": "error", "code": 404, "message": "Image not found"})");
+                co_await flushOutput(conn);
+                co_return false;
+            }
+            // 앞선 응답과 길이 헤더를 본문 첫 조각과 함께 보낸다
+            std::string prefix = std::move(conn.out);
+            conn.out.clear();
+            size_t pos = prefix.size();
+            prefix.resize(pos + sizeof(uint64_t));
+            writeBE64(&prefix[pos], fileSize);
+            co_await sendImage(conn, fd, fileSize, std::move(prefix));
+            close(fd);
+            co_return false;
+
+        } else if (command == CommandId::Proto) {
+            std::string_view mode;
+            if (!parseArgs(commandArgs(cmd), 1, mode)) mode = {};
+            std::string resp;
+            if (mode == "BINARY") {
+                resp = R"({"status": "success", "code": 200, "message": "Binary framing enabled", "version": 1})";
+            } else if (mode == "TEXT") {
+                resp = R"({"status": "success", "code": 200, "message": "Text protocol"})";
+            } else {
+                resp = R"({"status": "error", "code": 400, "message": "Unknown protocol"})";
+            }
+            resp.push_back('\n');
+            if (!co_await respond(conn, resp)) co_return false;
+            if (mode == "BINARY") co_return co_await serveBinary(conn);
+
+        } else if (command == CommandId::SubscribeEvents) {
+            int eventType;
+            if (!parseSubscribe(cmd, eventType)) {
+                if (!co_await respond(conn, R"({"status": "error", "code": 400, "message": "Invalid event type"})" "\n")) {
+                    co_return false;
+                }
+                continue;
+            }
+            co_return co_await serveEvents(conn, eventType);
+
+        } else {
+            // 조회 명령이면 이미 도착한 뒤따르는 조회 명령을 함께 실행하고 요청 순서대로 응답
+            std::vector<std::string> batch{cmd};
+            size_t lineLen;
+            while (CommandHandler::isReadOnly(cmd) &&
+                   batch.size() < static_cast<size_t>(cfg.pipelineDepth) &&
+                   (lineLen = conn.in.findLine()) > 0) {
+                std::string next(conn.in.data(), lineLen);
+                if (!CommandHandler::isReadOnly(next)) break;
+                conn.in.consume(lineLen);
+                LOG_INFO("[TcpServer] Received: ", next);
+                batch.push_back(std::move(next));
+            }
+
+            std::vector<std::string> results;
+            co_await PoolAwaiter(this, batch, results);
+            for (std::string& resp : results) {
+                if (resp.empty() || resp.back() != '\n') resp.push_back('\n');
+                if (!co_await respond(conn, resp)) co_return false;
+            }
+        }
+    }
+}
+
+// 구독 대기열에서 꺼낸 줄을 보내고, 다음 이벤트나 연결 종료를 기다린다.
+// 발행 스레드의 wake 는 루프로 넘어와 기다리던 코루틴을 깨우므로 대기 중인 I/O 는 다시 시도된다
+Async<bool> CoroLoop::serveEvents(CoroConn& conn, int eventType) {
+    const ServerConfig& cfg = server->getConfig();
+    EventBroadcaster& broadcaster = EventBroadcaster::instance();
+    uint64_t id = conn.id;
+    auto sub = broadcaster.subscribe(eventType, [this, id] {
+        post([this, id] {
+            auto it = conns.find(id);
+            if (it != conns.end() && it->second->waiter) {
+                std::exchange(it->second->waiter, nullptr).resume();
+            }
+        });
+    });
+
+    std::string ack = kSubscribedResponse;
+    ack.push_back('\n');
+    bool ok = co_await respond(conn, ack);
+    std::vector<EventLine> lines;
+    char discard[512];
+    while (ok) {
+        lines.clear();
+        bool alive = sub->take(lines);
+        for (const EventLine& line : lines) conn.out += *line;
+        serverMetrics().eventsSent += lines.size();
+        if (!alive) {
+            LOG_WARN("[TcpServer] Subscriber too slow, closing fd=", conn.fd);
+            conn.out += kSubscriberTooSlowResponse;
+            conn.out += '\n';
+        }
+        // 보내는 동안에만 유휴 제한 시간으로 못 읽는 구독자를 끊는다
+        arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+        if (!co_await flushOutput(conn) || !alive) break;
+        if (lines.size() == EventSubscription::kQueueLimit) continue;  // 더 남았을 수 있다
+
+        // 이벤트를 기다리는 동안에는 제한 시간 없이 유지 (드레인 때는 닫는다)
+        if (draining && !bytesPending(conn.fd)) break;
+        arm(conn, TimeoutKind::None, 0);
+        if (SSL_pending(conn.ssl) == 0) {
+            conn.betweenRequests = true;
+            ok = co_await waitIo(conn, EPOLLIN);
+            conn.betweenRequests = false;
+            if (!ok) break;
+        }
+        // 구독 중에는 명령을 받지 않는다. 들어온 바이트는 읽고 버린다
+        ERR_clear_error();
+        int n = SSL_read(conn.ssl, discard, sizeof(discard));
+        if (n <= 0) {
+            int err = SSL_get_error(conn.ssl, n);
+            ok = err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+        }
+    }
+
+    broadcaster.unsubscribe(sub);
+    co_return false;
+}
+
+// PROTO BINARY 이후의 프레임 루프. 스레드 모드 serveBinary 와 같은 흐름
+Async<bool> CoroLoop::serveBinary(CoroConn& conn) {
+    const ServerConfig& cfg = server->getConfig();
+    ImageHandler* imageHandler = server->getImageHandler();
+
+    while (true) {
+        if (!co_await readExact(conn, FrameHeader::kSize)) co_return false;
+        FrameHeader h = FrameHeader::decode(conn.in.data());
+        std::string frame;
+
+        if (h.opcode == kFrameUpload && imageHandler) {
+            if (!co_await readExact(conn, FrameHeader::kSize + 2)) co_return false;
+            size_t nameLen = readBE16(conn.in.data() + FrameHeader::kSize);
+            if (h.length < 2 + nameLen) {
+                LOG_WARN("[TcpServer] Malformed upload frame, closing fd=", conn.fd);
+                co_return false;
+            }
+            if (!co_await readExact(conn, FrameHeader::kSize + 2 + nameLen)) co_return false;
+            std::string filename(conn.in.data() + FrameHeader::kSize + 2, nameLen);
+            size_t filesize = h.length - 2 - nameLen;
+            conn.in.consume(FrameHeader::kSize + 2 + nameLen);
+            LOG_INFO("[TcpServer] Received frame: UPLOAD ", filename, " ", filesize);
+
+            std::string result;
+            if (!co_await receiveUpload(conn, filename, filesize, true, result)) co_return false;
+            arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+            appendJsonResponse(frame, kFrameUpload, h.requestId, result);
+            if (!co_await respond(conn, frame)) co_return false;
+            continue;
+        }
+
+        if (h.length > ReadBuffer::kMaxLineLength) {
+            LOG_WARN("[TcpServer] Frame too large, closing fd=", conn.fd);
+            co_return false;
+        }
+        if (!co_await readExact(conn, FrameHeader::kSize + h.length)) co_return false;
+        std::string payload(conn.in.data() + FrameHeader::kSize, h.length);
+        conn.in.consume(FrameHeader::kSize + h.length);
+        arm(conn, TimeoutKind::Idle, cfg.idleTimeoutMs);
+
+        if (h.opcode == kFrameCommand) {
+            LOG_INFO("[TcpServer] Received frame: ", payload);
+            // 텍스트 모드와 같이 이미 도착한 조회 명령 프레임을 함께 실행
+            std::vector<std::string> batch{payload};
+            std::vector<uint32_t>    requestIds{h.requestId};
+            while (CommandHandler::isReadOnly(payload) &&
+                   batch.size() < static_cast<size_t>(cfg.pipelineDepth) &&
+                   conn.in.size() >= FrameHeader::kSize) {
+                FrameHeader next = FrameHeader::decode(conn.in.data());
+                if (next.opcode != kFrameCommand ||
+                    conn.in.size() < FrameHeader::kSize + next.length) break;
+                std::string nextCmd(conn.in.data() + FrameHeader::kSize, next.length);
+                if (!CommandHandler::isReadOnly(nextCmd)) break;
+                conn.in.consume(FrameHeader::kSize + next.length);
+                LOG_INFO("[TcpServer] Received frame: ", nextCmd);
+                batch.push_back(std::move(nextCmd));
+                requestIds.push_back(next.requestId);
+            }
+
+            std::vector<std::string> results;
+            co_await PoolAwaiter(this, batch, results);
+            for (size_t i = 0; i < results.size(); ++i) {
+                frame.clear();
+                appendJsonResponse(frame, kFrameCommand, requestIds[i], results[i]);
+                if (!co_await respond(conn, frame)) co_return false;
+            }
+            continue;
+        } else if (h.opcode == kFrameGetImage && imageHandler) {
+            LOG_INFO("[TcpServer] Received frame: GET_IMAGE ", payload);
+            size_t fileSize = 0;
+            int fd = ImageHandler::openImage(payload, fileSize);
+            if (fd >= 0 && fileSize <= UINT32_MAX) {
+                FrameHeader rh;
+                rh.opcode    = kFrameGetImage | kFrameResponse;
+                rh.requestId = h.requestId;
+                rh.length    = static_cast<uint32_t>(fileSize);
+                std::string prefix = std::move(conn.out);
+                conn.out.clear();
+                size_t pos = prefix.size();
+                prefix.resize(pos + FrameHeader::kSize);
+                rh.encode(&prefix[pos]);
+                bool ok = co_await sendImage(conn, fd, fileSize, std::move(prefix));
+                close(fd);
+                if (!ok) co_return false;
+                continue;
+            }
+            if (fd >= 0) {
+                close(fd);
+                appendJsonResponse(frame, kFrameGetImage, h.requestId,
+                                   R"({"status": "error", "code": 413, "message": "Image too large for frame"})");
+            } else {
+                appendJsonResponse(frame, kFrameGetImage, h.requestId,
+                                   payload.empty()
+                                       ? R"({"status": "error", "code": 400, "message": "Missing image path"})"
+                                       : R"({"status": "error", "code": 404, "message": "Image not found"})");
+            }
+        } else {
+            appendJsonResponse(frame, h.opcode, h.requestId,
+                               R"({"status": "error", "code": 400, "message": "Unknown opcode"})");
+        }
+        if (!co_await respond(conn, frame)) co_return false;
+    }
+}
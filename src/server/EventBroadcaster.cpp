@@ -0,0 +1,157 @@
+// src/server/EventBroadcaster.cpp
+
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+
+#include "server/EventBroadcaster.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/Logger.hpp"
+
+EventSubscription::EventSubscription(int eventType, std::function<void()> wake)
+  : eventType(eventType), wake(std::move(wake)) {}
+
+bool EventSubscription::take(std::vector<EventLine>& out, size_t max) {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t n = std::min(max, queue.size());
+    for (size_t i = 0; i < n; ++i) {
+        out.push_back(std::move(queue.front()));
+        queue.pop_front();
+    }
+    return !overflowed;
+}
+
+bool EventSubscription::push(const EventLine& line) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (overflowed) return true;
+    if (queue.size() >= kQueueLimit) {
+        // 못 따라오는 구독자: 쌓인 것은 버리고 끊는다 (연결 쪽이 마지막 에러 줄을 보낸다)
+        overflowed = true;
+        queue.clear();
+        if (wake) wake();
+        return true;
+    }
+    queue.push_back(line);
+    if (queue.size() == 1 && wake) wake();
+    return false;
+}
+
+void EventSubscription::cancel() {
+    std::lock_guard<std::mutex> lock(mtx);
+    wake = nullptr;
+    queue.clear();
+}
+
+EventBroadcaster& EventBroadcaster::instance() {
+    static EventBroadcaster broadcaster;
+    return broadcaster;
+}
+
+std::shared_ptr<EventSubscription> EventBroadcaster::subscribe(int eventType,
+                                                               std::function<void()> wake) {
+    auto sub = std::make_shared<EventSubscription>(eventType, std::move(wake));
+    std::lock_guard<std::mutex> lock(mtx);
+    subs.push_back(sub);
+    serverMetrics().eventSubscribers++;
+    return sub;
+}
+
+void EventBroadcaster::unsubscribe(const std::shared_ptr<EventSubscription>& sub) {
+    if (!sub) return;
+    sub->cancel();
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = std::find(subs.begin(), subs.end(), sub);
+    if (it != subs.end()) {
+        subs.erase(it);
+        serverMetrics().eventSubscribers--;
+    }
+}
+
+bool EventBroadcaster::hasSubscribers() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return !subs.empty();
+}
+
+void EventBroadcaster::publish(int eventType, std::string line) {
+    ServerMetrics& m = serverMetrics();
+    m.eventsPublished++;
+    EventLine shared = std::make_shared<const std::string>(std::move(line));
+
+    // 대기열에 넣는 동안 목록을 잡고 있지만, 넣기는 상수 시간이고 wake 는 깨우기만 한다
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = subs.begin(); it != subs.end();) {
+        EventSubscription& sub = **it;
+        if (sub.eventType >= 0 && sub.eventType != eventType) {
+            ++it;
+            continue;
+        }
+        m.eventsQueued++;
+        if (sub.push(shared)) {
+            m.eventSubscribersDropped++;
+            m.eventSubscribers--;
+            it = subs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool parseSubscribe(std::string_view cmd, int& eventType) {
+    ArgReader reader(commandArgs(cmd));
+    std::string_view type;
+    eventType = -1;
+    if (!reader.next(type)) return true;  // 인자가 없으면 전체
+    return parseArg(type, eventType) && reader.done() && eventType >= 0 && eventType <= 2;
+}
+
+void streamEvents(int fd, int eventType, const std::function<bool(std::string_view)>& send,
+                  const std::function<bool()>& readInput) {
+    int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0) {
+        logErrno("eventfd");
+        return;
+    }
+    EventBroadcaster& broadcaster = EventBroadcaster::instance();
+    // 응답보다 먼저 등록해 그 사이에 커밋된 레코드도 놓치지 않는다
+    auto sub = broadcaster.subscribe(eventType, [wakeFd] {
+        uint64_t one = 1;
+        ssize_t r = write(wakeFd, &one, sizeof(one));
+        (void)r;
+    });
+
+    std::string out = kSubscribedResponse;
+    out.push_back('\n');
+    std::vector<EventLine> lines;
+    serverMetrics().responsesSent++;
+    bool open = send(out);
+    while (open) {
+        out.clear();
+        lines.clear();
+        bool alive = sub->take(lines);
+        for (const EventLine& line : lines) out += *line;
+        if (!alive) out += std::string(kSubscriberTooSlowResponse) + "\n";
+        serverMetrics().eventsSent += lines.size();
+        if (!out.empty() && !send(out)) break;
+        if (!alive) break;
+        if (lines.size() == EventSubscription::kQueueLimit) continue;  // 더 남았을 수 있다
+
+        pollfd pfds[2] = {{fd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        if (poll(pfds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            logErrno("poll");
+            break;
+        }
+        if (pfds[0].revents & (POLLIN | POLLHUP | POLLERR)) open = readInput();
+        if (pfds[1].revents & POLLIN) {
+            uint64_t cnt;
+            ssize_t r = read(wakeFd, &cnt, sizeof(cnt));
+            (void)r;
+        }
+    }
+
+    broadcaster.unsubscribe(sub);
+    close(wakeFd);
+}
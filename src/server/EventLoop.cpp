@@ -0,0 +1,882 @@
+// src/server/EventLoop.cpp
+
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "server/EventLoop.hpp"
+#include "server/EventBroadcaster.hpp"
+#include "server/Frame.hpp"
+#include "server/TcpServer.hpp"
+#include "server/CommandHandler.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/CommandTable.hpp"
+#include "server/ImageHandler.hpp"
+#include "server/RecordWriter.hpp"
+#include "server/ServerMetrics.hpp"
+#include "server/WorkerPool.hpp"
+#include "server/TlsSessionCache.hpp"
+#include "util/EndianUtils.hpp"
+#include "util/Logger.hpp"
+
+// main.cpp 에서 초기화된 commandHandler
+extern CommandHandler* commandHandler;
+
+namespace {
+constexpr int    kReadsPerEvent  = 16;          // 한 연결이 루프를 독점하지 않도록 제한
+constexpr size_t kOutHighWater   = 256 * 1024;  // 송신 대기량이 이보다 크면 새 명령 처리 보류
+constexpr int    kMaxEvents      = 64;
+}
+
+EventLoop::EventLoop(TcpServer* server, int index)
+  : server(server), index(index), epfd(-1), wakeFd(-1), listenFd(-1),
+    ownsAccepted(false), draining(false), nextId(2), timers(kTimerTick, kTimerSlots) {
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        logErrno("epoll_create1");
+        exit(EXIT_FAILURE);
+    }
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        logErrno("eventfd");
+        exit(EXIT_FAILURE);
+    }
+    epoll_event ev{};
+    ev.events   = EPOLLIN;
+    ev.data.u64 = kWakeupId;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, wakeFd, &ev);
+}
+
+EventLoop::~EventLoop() {
+    for (auto& kv : conns) {
+        Connection& conn = *kv.second;
+        if (conn.ssl) SSL_free(conn.ssl);
+        close(conn.fd);
+    }
+    if (wakeFd != -1) close(wakeFd);
+    if (epfd != -1) close(epfd);
+}
+
+void EventLoop::addListener(int listen_fd, bool ownsAccepted) {
+    listenFd = listen_fd;
+    this->ownsAccepted = ownsAccepted;
+    int flags = fcntl(listenFd, F_GETFL, 0);
+    fcntl(listenFd, F_SETFL, flags | O_NONBLOCK);
+
+    epoll_event ev{};
+    ev.events   = EPOLLIN;
+    ev.data.u64 = kListenerId;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listenFd, &ev);
+}
+
+void EventLoop::drain() {
+    if (listenFd >= 0) {
+        epoll_ctl(epfd, EPOLL_CTL_DEL, listenFd, nullptr);
+        listenFd = -1;
+    }
+    draining = true;
+
+    std::vector<uint64_t> idle;
+    for (const auto& [id, conn] : conns) {
+        if (betweenRequests(*conn) && !bytesPending(conn->fd)) idle.push_back(id);
+    }
+    for (uint64_t id : idle) closeConnection(*conns[id]);
+    // 나머지는 요청을 끝낸 뒤 onEvent 에서 닫힌다
+}
+
+bool EventLoop::betweenRequests(const Connection& conn) const {
+    bool waiting = conn.state == ConnState::Reading || conn.state == ConnState::Subscribed;
+    return conn.served && waiting && conn.inflight.empty() &&
+           conn.in.empty() && conn.discard == 0 && conn.outOffset >= conn.out.size();
+}
+
+void EventLoop::adoptConnection(int client_fd) {
+    post([this, client_fd] { addConnection(client_fd); });
+}
+
+void EventLoop::post(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(postMtx);
+        posted.push_back(std::move(fn));
+    }
+    uint64_t one = 1;
+    ssize_t r = write(wakeFd, &one, sizeof(one));
+    (void)r;
+}
+
+void EventLoop::runPosted() {
+    uint64_t cnt;
+    while (read(wakeFd, &cnt, sizeof(cnt)) > 0) {}
+
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(postMtx);
+        tasks.swap(posted);
+    }
+    for (auto& fn : tasks) fn();
+}
+
+void EventLoop::run() {
+    LOG_INFO("[EventLoop ", index, "] running");
+    epoll_event events[kMaxEvents];
+
+    while (true) {
+        int n = epoll_wait(epfd, events, kMaxEvents, nextTimeoutMs());
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            logErrno("epoll_wait");
+            continue;
+        }
+
+        // 이전 반복에서 읽기 한도에 걸려 SSL 버퍼에 남은 데이터 처리
+        if (!pendingReads.empty()) {
+            std::vector<uint64_t> ids;
+            ids.swap(pendingReads);
+            for (uint64_t id : ids) {
+                auto it = conns.find(id);
+                if (it != conns.end()) onEvent(*it->second, EPOLLIN);
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            uint64_t id = events[i].data.u64;
+            if (id == kListenerId) {
+                acceptAll();
+            } else if (id == kWakeupId) {
+                runPosted();
+            } else {
+                auto it = conns.find(id);
+                if (it == conns.end()) continue;  // 같은 배치에서 이미 닫힌 연결
+                onEvent(*it->second, events[i].events);
+            }
+        }
+
+        expireTimers();
+    }
+}
+
+int EventLoop::nextTimeoutMs() const {
+    if (!pendingReads.empty()) return 0;
+    return timers.nextTimeoutMs(TimerWheel::Clock::now());
+}
+
+// 제한 시간이 지난 연결 정리
+void EventLoop::expireTimers() {
+    std::vector<uint64_t> expired;
+    timers.advance(TimerWheel::Clock::now(), expired);
+    for (uint64_t id : expired) {
+        auto it = conns.find(id);
+        if (it == conns.end()) continue;
+        Connection& conn = *it->second;
+        LOG_WARN("[TcpServer] ", timeoutName(conn.timeout), " timeout, closing fd=", conn.fd);
+        countTimeout(conn.timeout);
+        closeConnection(conn);
+    }
+}
+
+// 연결이 지금 기다리는 것에 맞춰 제한 시간을 다시 건다 (이벤트 처리 후마다 호출)
+void EventLoop::armTimer(Connection& conn) {
+    const ServerConfig& cfg = server->getConfig();
+    TimeoutKind kind;
+    int timeoutMs;
+    if (conn.state == ConnState::Uploading) {
+        // 본문이 조금이라도 들어왔을 때만 연장
+        if (conn.timeout == TimeoutKind::Upload && conn.upload.received == conn.timeoutMark) return;
+        kind = TimeoutKind::Upload;
+        timeoutMs = cfg.uploadTimeoutMs;
+        conn.timeoutMark = conn.upload.received;
+    } else if (conn.state == ConnState::Subscribed && conn.outOffset >= conn.out.size()) {
+        // 구독 중에는 이벤트가 뜸해도 끊지 않는다. 보낼 것이 밀려 있을 때만 유휴 제한 시간
+        conn.timeout = TimeoutKind::None;
+        timers.cancel(conn.id);
+        return;
+    } else if (conn.state == ConnState::Reading && conn.inflight.empty() && !conn.in.empty() &&
+               !readPaused(conn)) {
+        // 줄이 끝나지 않은 채 남아 있음: 첫 바이트부터 잰다
+        if (conn.timeout == TimeoutKind::Header) return;
+        kind = TimeoutKind::Header;
+        timeoutMs = cfg.headerTimeoutMs;
+    } else {
+        // 명령 대기, 실행, 응답 송신 중에는 활동이 있을 때마다 연장
+        kind = TimeoutKind::Idle;
+        timeoutMs = cfg.idleTimeoutMs;
+    }
+
+    conn.timeout = kind;
+    if (timeoutMs <= 0) {
+        timers.cancel(conn.id);
+        return;
+    }
+    timers.schedule(conn.id, TimerWheel::Clock::now() + std::chrono::milliseconds(timeoutMs));
+}
+
+// 대기 중인 연결을 한 번에 받되, 다른 연결이 굶지 않도록 acceptBatch 개까지만.
+// 리스너는 level-triggered 라 남은 연결은 다음 epoll_wait 에서 다시 알려 준다
+void EventLoop::acceptAll() {
+    int batch = server->getConfig().acceptBatch;
+    for (int i = 0; i < batch; ++i) {
+        sockaddr_in client_addr{};
+        socklen_t len = sizeof(client_addr);
+        int client_fd = accept4(listenFd, (sockaddr*)&client_addr, &len,
+                                SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            logErrno("accept4");
+            return;
+        }
+        LOG_INFO("[TcpServer] TCP connection fd=", client_fd);
+        // 연결 상한 초과: TLS 전이라 응답 없이 바로 종료
+        if (!server->admitConnection()) {
+            LOG_WARN("[TcpServer] Connection limit reached, rejecting fd=", client_fd);
+            close(client_fd);
+            continue;
+        }
+        if (ownsAccepted) {
+            addConnection(client_fd);
+        } else {
+            server->dispatchConnection(client_fd);
+        }
+    }
+}
+
+// client_fd 는 accept4(SOCK_NONBLOCK) 로 받은 논블로킹 소켓
+void EventLoop::addConnection(int client_fd) {
+    SSL* ssl = SSL_new(server->getSslContext());
+    if (!ssl) {
+        logSslErrors();
+        close(client_fd);
+        server->releaseConnection();
+        return;
+    }
+    SSL_set_fd(ssl, client_fd);
+    // out 버퍼가 재할당되어도 WANT_WRITE 재시도가 가능하도록
+    SSL_set_mode(ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+    SSL_set_accept_state(ssl);
+
+    auto conn   = std::make_unique<Connection>();
+    conn->id    = nextId++;
+    conn->fd    = client_fd;
+    conn->ssl   = ssl;
+    conn->state = ConnState::Handshake;
+
+    Connection& ref = *conn;
+    conns.emplace(ref.id, std::move(conn));
+
+    serverMetrics().handshakesInFlight++;
+    ref.timeout = TimeoutKind::Handshake;
+    timers.schedule(ref.id, TimerWheel::Clock::now() +
+                                std::chrono::milliseconds(server->getConfig().handshakeTimeoutMs));
+
+    epoll_event ev{};
+    ev.events   = EPOLLIN;
+    ev.data.u64 = ref.id;
+    ref.events  = EPOLLIN;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, client_fd, &ev) < 0) {
+        logErrno("epoll_ctl");
+        closeConnection(ref);
+        return;
+    }
+    // ClientHello 가 이미 도착했을 수 있으므로 바로 시도
+    doHandshake(ref);
+}
+
+void EventLoop::closeConnection(Connection& conn) {
+    if (conn.state == ConnState::Uploading) {
+        server->getImageHandler()->abortUpload(conn.upload);
+    }
+    if (conn.imageFd >= 0) close(conn.imageFd);
+    if (conn.subscription) EventBroadcaster::instance().unsubscribe(conn.subscription);
+    timers.cancel(conn.id);
+    epoll_ctl(epfd, EPOLL_CTL_DEL, conn.fd, nullptr);
+    if (conn.state == ConnState::Handshake) {
+        serverMetrics().handshakesInFlight--;
+    }
+    if (conn.ssl) {
+        if (conn.state != ConnState::Handshake) SSL_shutdown(conn.ssl);
+        SSL_free(conn.ssl);
+        // 루프 스레드의 에러 큐는 모든 연결이 공유하므로 남기지 않는다
+        ERR_clear_error();
+    }
+    close(conn.fd);
+    server->releaseConnection();
+    conns.erase(conn.id);  // conn 은 여기서 소멸
+}
+
+void EventLoop::onEvent(Connection& conn, uint32_t events) {
+    if (conn.state == ConnState::Handshake) {
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            serverMetrics().handshakesFailed++;
+            closeConnection(conn);
+            return;
+        }
+        doHandshake(conn);
+        return;
+    }
+
+    bool readable = (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) ||
+                    ((events & EPOLLOUT) && conn.readWantsWrite);
+    if (readable && !doRead(conn)) return;
+    if (conn.state == ConnState::Subscribed) pumpEvents(conn);
+
+    // 새로 쌓인 응답은 EPOLLOUT 을 기다리지 않고 바로 보내 본다
+    if (writeDue(conn)) {
+        if (!doWrite(conn)) return;
+    }
+    if (draining && betweenRequests(conn) && !bytesPending(conn.fd)) {
+        closeConnection(conn);
+        return;
+    }
+    updateInterest(conn);
+    armTimer(conn);
+}
+
+void EventLoop::doHandshake(Connection& conn) {
+    ERR_clear_error();
+    int ret = SSL_accept(conn.ssl);
+    if (ret == 1) {
+        LOG_INFO("[TcpServer] SSL handshake OK (fd=", conn.fd, ")");
+        serverMetrics().handshakesInFlight--;
+        serverMetrics().handshakesCompleted++;
+        TlsSessionCache::recordHandshake(conn.ssl);
+        conn.state = ConnState::Reading;
+        // 핸드쉐이크와 같은 패킷에 명령이 붙어 왔을 수 있다
+        onEvent(conn, EPOLLIN);
+        return;
+    }
+
+    int err = SSL_get_error(conn.ssl, ret);
+    if (err == SSL_ERROR_WANT_READ) {
+        setInterest(conn, EPOLLIN);
+    } else if (err == SSL_ERROR_WANT_WRITE) {
+        setInterest(conn, EPOLLOUT);
+    } else {
+        logSslErrors();
+        serverMetrics().handshakesFailed++;
+        closeConnection(conn);
+    }
+}
+
+// SSL 에서 읽을 수 있는 만큼 읽어 처리한다. 연결이 닫혔으면 false
+bool EventLoop::doRead(Connection& conn) {
+    conn.readWantsWrite = false;
+    // 이전에 보류했던 명령부터 처리
+    if (!process(conn)) return false;
+
+    for (int i = 0; i < kReadsPerEvent; ++i) {
+        if (readPaused(conn)) return true;
+
+        char* dst = conn.in.prepareWrite();
+        ERR_clear_error();
+        int n = SSL_read(conn.ssl, dst, static_cast<int>(conn.in.writable()));
+        if (n > 0) {
+            conn.in.commit(n);
+            if (!process(conn)) return false;
+            continue;
+        }
+
+        int err = SSL_get_error(conn.ssl, n);
+        if (err == SSL_ERROR_WANT_READ) return true;
+        if (err == SSL_ERROR_WANT_WRITE) {
+            conn.readWantsWrite = true;
+            return true;
+        }
+        if (err != SSL_ERROR_ZERO_RETURN) logSslErrors();
+        closeConnection(conn);
+        return false;
+    }
+
+    // 읽기 한도 도달: 남은 데이터는 다음 반복에서 (소켓 이벤트가 없을 수도 있으므로)
+    pendingReads.push_back(conn.id);
+    return true;
+}
+
+// 송신 대기 바이트를 보낸다. 연결이 닫혔으면 false
+bool EventLoop::doWrite(Connection& conn) {
+    conn.writeWantsRead = false;
+
+    while (true) {
+        size_t pending = conn.out.size() - conn.outOffset;
+        // 본문 조각은 남은 응답 바이트(응답 헤더 등) 뒤에 이어 붙여 꽉 찬 레코드로 보낸다
+        if (conn.state == ConnState::SendingImage && !conn.imageKtls && pending < kTlsRecordSize) {
+            conn.out.erase(0, conn.outOffset);
+            conn.outOffset = 0;
+            if (!fillImageChunk(conn)) {
+                closeConnection(conn);
+                return false;
+            }
+            pending = conn.out.size();
+        }
+        if (pending == 0) {
+            conn.out.clear();
+            conn.outOffset = 0;
+            // 여기까지 SendingImage 면 kTLS 전송 (버퍼 경로는 위에서 채우거나 끝냈다)
+            if (conn.state == ConnState::SendingImage) {
+                int r = sendImageKtls(conn);
+                if (r < 0) return false;
+                if (r == 0) return true;  // EPOLLOUT 대기
+            }
+            break;
+        }
+
+        ERR_clear_error();
+        int n = SSL_write(conn.ssl, conn.out.data() + conn.outOffset, pending);
+        if (n > 0) {
+            conn.outOffset += n;
+            countTlsRecords(n);
+            continue;
+        }
+
+        int err = SSL_get_error(conn.ssl, n);
+        if (err == SSL_ERROR_WANT_WRITE) return true;
+        if (err == SSL_ERROR_WANT_READ) {
+            conn.writeWantsRead = true;
+            return true;
+        }
+        logSslErrors();
+        closeConnection(conn);
+        return false;
+    }
+
+    if (conn.closeAfterFlush) {
+        closeConnection(conn);
+        return false;
+    }
+
+    // 송신이 풀렸으니 보류했던 명령과 SSL 버퍼에 남은 데이터를 다음 반복에서 처리
+    if (!conn.in.empty() || SSL_pending(conn.ssl) > 0) {
+        pendingReads.push_back(conn.id);
+    }
+    return true;
+}
+
+// 수신 버퍼에 쌓인 바이트를 상태에 맞게 소비한다. 연결이 닫혔으면 false
+bool EventLoop::process(Connection& conn) {
+    while (true) {
+        // 거절한 바이너리 업로드의 본문 건너뛰기
+        if (conn.discard > 0) {
+            size_t skip = std::min(conn.in.size(), conn.discard);
+            conn.in.consume(skip);
+            conn.discard -= skip;
+            if (conn.discard > 0) return true;
+        }
+
+        if (conn.state == ConnState::Uploading) {
+            UploadSession& up = conn.upload;
+            size_t take = std::min(conn.in.size(), up.filesize - up.received);
+            if (take > 0) {
+                up.write(conn.in.data(), take);
+                up.received += take;
+                conn.in.consume(take);
+            }
+            if (up.received < up.filesize) return true;
+
+            std::string result = server->getImageHandler()->finishUpload(up);
+            appendResponse(conn, kFrameUpload, conn.uploadRequestId, result);
+            conn.upload = UploadSession();
+            conn.state = ConnState::Reading;
+            continue;
+        }
+
+        // 구독 연결은 더 이상 명령을 받지 않는다
+        if (conn.state == ConnState::Subscribed) {
+            conn.in.consume(conn.in.size());
+            return true;
+        }
+        if (conn.state != ConnState::Reading) return true;
+        if (conn.closeAfterFlush || conn.barrier) return true;
+        if (conn.out.size() - conn.outOffset > kOutHighWater) return true;
+
+        if (conn.binary) {
+            int r = processFrame(conn);
+            if (r < 0) return false;
+            if (r == 0) return true;
+            continue;
+        }
+
+        size_t lineLen = conn.in.findLine();
+        if (lineLen == 0) {
+            if (conn.in.size() > ReadBuffer::kMaxLineLength) {
+                LOG_WARN("[TcpServer] Line too long, closing fd=", conn.fd);
+                closeConnection(conn);
+                return false;
+            }
+            return true;
+        }
+
+        std::string cmd(conn.in.data(), lineLen);
+        if (cmd == "\n") {
+            conn.in.consume(lineLen);
+            continue;
+        }
+        // 앞선 명령을 기다려야 하면 줄을 버퍼에 남겨 두고 응답 도착 시 다시 시도
+        if (!canStart(conn, cmd)) return true;
+        conn.in.consume(lineLen);
+
+        processLine(conn, cmd);
+    }
+}
+
+// 조회 명령은 pipelineDepth 개까지 겹쳐 실행, 나머지는 앞선 명령이 모두 끝난 뒤 단독 실행
+bool EventLoop::canStart(const Connection& conn, const std::string& cmd) const {
+    if (conn.inflight.empty()) return true;
+    if (!CommandHandler::isReadOnly(cmd)) return false;
+    return conn.inflight.size() < static_cast<size_t>(server->getConfig().pipelineDepth);
+}
+
+void EventLoop::processLine(Connection& conn, const std::string& cmd) {
+    LOG_INFO("[TcpServer] Received: ", cmd);
+    conn.served = true;
+    ImageHandler* imageHandler = server->getImageHandler();
+    CommandId command = commandId(cmd);
+
+    // UPLOAD 처리
+    if (command == CommandId::Upload && imageHandler) {
+        std::string_view filename;
+        size_t filesize = 0;
+        if (!parseArgs(commandArgs(cmd), 2, filename, filesize)) filesize = 0;
+        startUpload(conn, 0, std::string(filename), filesize);
+        return;
+    }
+
+    // GET_IMAGE 처리: 길이 헤더 후 본문을 나눠 보내고 연결 종료 (기존 프로토콜과 동일)
+    if (command == CommandId::GetImage && imageHandler) {
+        std::string_view imagePath;
+        if (!parseArgs(commandArgs(cmd), 1, imagePath)) imagePath = {};
+        startImage(conn, 0, std::string(imagePath));
+        return;
+    }
+
+    // 이벤트 구독: 응답 후 이 연결은 새 히스토리 레코드를 한 줄씩 받기만 한다
+    if (command == CommandId::SubscribeEvents) {
+        int eventType;
+        if (!parseSubscribe(cmd, eventType)) {
+            appendResponse(conn, kFrameCommand, 0,
+                           R"({"status": "error", "code": 400, "message": "Invalid event type"})");
+            return;
+        }
+        uint64_t id = conn.id;
+        // 발행은 작업 풀 스레드에서 일어나므로 루프로 넘겨서 꺼낸다
+        conn.subscription = EventBroadcaster::instance().subscribe(eventType, [this, id] {
+            post([this, id] {
+                auto it = conns.find(id);
+                if (it != conns.end()) onEvent(*it->second, 0);
+            });
+        });
+        appendResponse(conn, kFrameCommand, 0, kSubscribedResponse);
+        conn.state = ConnState::Subscribed;
+        return;
+    }
+
+    // 프레이밍 협상: 응답은 텍스트로 보내고 다음 바이트부터 바이너리 프레임
+    if (command == CommandId::Proto) {
+        std::string_view mode;
+        if (!parseArgs(commandArgs(cmd), 1, mode)) mode = {};
+        if (mode == "BINARY") {
+            conn.out += R"({"status": "success", "code": 200, "message": "Binary framing enabled", "version": 1})";
+            conn.out += '\n';
+            conn.binary = true;
+        } else if (mode == "TEXT") {
+            conn.out += R"({"status": "success", "code": 200, "message": "Text protocol"})";
+            conn.out += '\n';
+        } else {
+            conn.out += R"({"status": "error", "code": 400, "message": "Unknown protocol"})";
+            conn.out += '\n';
+        }
+        return;
+    }
+
+    startCommand(conn, kFrameCommand, 0, cmd);
+}
+
+// 바이너리 모드에서 프레임 하나 처리. 1: 처리함, 0: 데이터 부족/대기, -1: 연결 종료됨
+int EventLoop::processFrame(Connection& conn) {
+    if (conn.in.size() < FrameHeader::kSize) return 0;
+    FrameHeader h = FrameHeader::decode(conn.in.data());
+
+    // 업로드는 파일명까지만 모이면 시작하고 본문은 흘려서 받는다
+    if (h.opcode == kFrameUpload) {
+        if (conn.in.size() < FrameHeader::kSize + 2) return 0;
+        size_t nameLen = readBE16(conn.in.data() + FrameHeader::kSize);
+        if (h.length < 2 + nameLen) {
+            LOG_WARN("[TcpServer] Malformed upload frame, closing fd=", conn.fd);
+            closeConnection(conn);
+            return -1;
+        }
+        if (conn.in.size() < FrameHeader::kSize + 2 + nameLen) return 0;
+        if (!conn.inflight.empty()) return 0;
+
+        std::string filename(conn.in.data() + FrameHeader::kSize + 2, nameLen);
+        size_t filesize = h.length - 2 - nameLen;
+        conn.in.consume(FrameHeader::kSize + 2 + nameLen);
+        LOG_INFO("[TcpServer] Received frame: UPLOAD ", filename, " ", filesize);
+        if (!startUpload(conn, h.requestId, filename, filesize)) conn.discard = filesize;
+        return 1;
+    }
+
+    // 나머지 프레임은 한 줄 명령과 같은 크기 제한
+    if (h.length > ReadBuffer::kMaxLineLength) {
+        LOG_WARN("[TcpServer] Frame too large, closing fd=", conn.fd);
+        closeConnection(conn);
+        return -1;
+    }
+    if (conn.in.size() < FrameHeader::kSize + h.length) return 0;
+
+    std::string payload(conn.in.data() + FrameHeader::kSize, h.length);
+    if (h.opcode == kFrameCommand) {
+        if (!canStart(conn, payload)) return 0;
+    } else if (!conn.inflight.empty()) {
+        return 0;
+    }
+    conn.in.consume(FrameHeader::kSize + h.length);
+
+    switch (h.opcode) {
+        case kFrameCommand:
+            LOG_INFO("[TcpServer] Received frame: ", payload);
+            startCommand(conn, kFrameCommand, h.requestId, payload);
+            break;
+        case kFrameGetImage:
+            LOG_INFO("[TcpServer] Received frame: GET_IMAGE ", payload);
+            startImage(conn, h.requestId, payload);
+            break;
+        default:
+            appendResponse(conn, h.opcode, h.requestId,
+                           R"({"status": "error", "code": 400, "message": "Unknown opcode"})");
+            break;
+    }
+    return 1;
+}
+
+// 업로드 시작. 거절했으면 false (바이너리 모드에서는 본문을 건너뛰어야 함)
+bool EventLoop::startUpload(Connection& conn, uint32_t requestId, const std::string& filename,
+                            size_t filesize) {
+    if (filename.empty() || filesize == 0) {
+        appendResponse(conn, kFrameUpload, requestId,
+                       R"({"status":"error","code":400,"message":"Invalid filename or filesize"})");
+        return false;
+    }
+    std::string err = server->getImageHandler()->beginUpload(filename, filesize, conn.upload);
+    if (!err.empty()) {
+        appendResponse(conn, kFrameUpload, requestId, err);
+        return false;
+    }
+    conn.uploadRequestId = requestId;
+    conn.state = ConnState::Uploading;
+    return true;
+}
+
+// 텍스트 모드: 8바이트 길이 헤더 + 본문 후 연결 종료, 에러는 개행 없는 JSON (기존 프로토콜).
+// 바이너리 모드: 응답 프레임 헤더 + 본문, 연결 유지
+void EventLoop::startImage(Connection& conn, uint32_t requestId, const std::string& imagePath) {
+    const char* error = nullptr;
+    size_t fileSize = 0;
+    if (imagePath.empty()) {
+        error = R"({"status": "error", "code": 400, "message": "Missing image path"})";
+    } else if ((conn.imageFd = ImageHandler::openImage(imagePath, fileSize)) < 0) {
+        error = R"({"status": "error", "code": 404, "message": "Image not found"})";
+    } else if (conn.binary && fileSize > UINT32_MAX) {
+        close(conn.imageFd);
+        conn.imageFd = -1;
+        error = R"({"status": "error", "code": 413, "message": "Image too large for frame"})";
+    }
+
+    if (!conn.binary) conn.closeAfterFlush = true;
+    serverMetrics().responsesSent++;
+    if (error) {
+        if (conn.binary) {
+            appendJsonResponse(conn.out, kFrameGetImage, requestId, error);
+        } else {
+            conn.out += error;
+        }
+        return;
+    }
+
+    conn.imageOffset = 0;
+    conn.imageSize   = fileSize;
+    conn.imageKtls   = ImageHandler::ktlsSendEnabled(conn.ssl);
+
+    if (conn.binary) {
+        FrameHeader h;
+        h.opcode    = kFrameGetImage | kFrameResponse;
+        h.requestId = requestId;
+        h.length    = static_cast<uint32_t>(fileSize);
+        size_t pos = conn.out.size();
+        conn.out.resize(pos + FrameHeader::kSize);
+        h.encode(&conn.out[pos]);
+    } else {
+        uint64_t netFileSize = htonll(fileSize);
+        conn.out.append(reinterpret_cast<const char*>(&netFileSize), sizeof(netFileSize));
+    }
+    conn.state = ConnState::SendingImage;
+}
+
+// 나머지 명령은 DB 작업이므로 작업 풀에서 실행하고 결과를 루프로 돌려받는다.
+// 응답 자리를 먼저 잡아 두어 먼저 끝난 명령이 앞선 응답을 앞지르지 않게 한다
+void EventLoop::startCommand(Connection& conn, uint16_t opcode, uint32_t requestId,
+                             const std::string& cmd) {
+    uint64_t id  = conn.id;
+    uint64_t seq = conn.inflightBase + conn.inflight.size();
+    if (!conn.inflight.empty()) serverMetrics().jobsPipelined++;
+    conn.inflight.emplace_back();
+    conn.inflight.back().opcode    = opcode;
+    conn.inflight.back().requestId = requestId;
+
+    bool queued = server->getWorkerPool()->trySubmit([this, id, seq, cmd] {
+        std::string resp = commandHandler->handle(cmd);
+        post([this, id, seq, resp = std::move(resp)]() mutable {
+            completeCommand(id, seq, std::move(resp));
+        });
+    });
+    if (!queued) {
+        deliver(conn, seq, kServerBusyResponse);
+        return;
+    }
+    if (!CommandHandler::isReadOnly(cmd)) conn.barrier = true;
+}
+
+// 응답 하나를 현재 프레이밍에 맞춰 out 에 붙인다
+void EventLoop::appendResponse(Connection& conn, uint16_t opcode, uint32_t requestId,
+                               const std::string& resp) {
+    serverMetrics().responsesSent++;
+    if (conn.binary) {
+        appendJsonResponse(conn.out, opcode, requestId, resp);
+        return;
+    }
+    conn.out += resp;
+    if (resp.empty() || resp.back() != '\n') conn.out += '\n';
+}
+
+void EventLoop::completeCommand(uint64_t id, uint64_t seq, std::string resp) {
+    auto it = conns.find(id);
+    if (it == conns.end()) return;  // 실행 중에 연결이 끊김
+    Connection& conn = *it->second;
+
+    deliver(conn, seq, std::move(resp));
+    // 보류했던 다음 명령 처리 + 응답 송신
+    onEvent(conn, EPOLLIN);
+}
+
+// seq 번 응답을 채우고, 앞에서부터 준비된 응답을 순서대로 out 으로 옮긴다
+void EventLoop::deliver(Connection& conn, uint64_t seq, std::string resp) {
+    ResponseSlot& slot = conn.inflight[seq - conn.inflightBase];
+    slot.ready = true;
+    slot.body  = std::move(resp);
+
+    while (!conn.inflight.empty() && conn.inflight.front().ready) {
+        const ResponseSlot& front = conn.inflight.front();
+        appendResponse(conn, front.opcode, front.requestId, front.body);
+        conn.inflight.pop_front();
+        conn.inflightBase++;
+    }
+    // 단독 실행하던 명령은 항상 혼자이므로 비었으면 끝난 것
+    if (conn.inflight.empty()) conn.barrier = false;
+}
+
+// 송신이 밀렸거나, 명령 실행 중에 수신 버퍼가 너무 커지면 읽기 중단
+bool EventLoop::readPaused(const Connection& conn) const {
+    if (conn.out.size() - conn.outOffset > kOutHighWater) return true;
+    return !conn.inflight.empty() && conn.in.size() >= ReadBuffer::kMaxLineLength;
+}
+
+// 보낼 때가 된 응답이 있는지. 실행 중인 명령이 남아 있으면 그 응답과 한 레코드로
+// 합치도록 꽉 찬 레코드 분량이 모일 때까지 기다린다 (배치 끝에 한 번에 송신)
+bool EventLoop::writeDue(const Connection& conn) const {
+    if (conn.state == ConnState::SendingImage) return true;
+    size_t pending = conn.out.size() - conn.outOffset;
+    return pending > 0 && (conn.inflight.empty() || pending >= kTlsRecordSize);
+}
+
+// 다음 본문 조각을 out 뒤에 채운다 (kTLS 가 아닐 때). 남은 바이트와 합쳐 kImageChunk 까지.
+// 파일이 전송 중 줄어 알린 길이만큼 보낼 수 없으면 false (연결을 닫아야 함)
+bool EventLoop::fillImageChunk(Connection& conn) {
+    size_t pos  = conn.out.size();
+    size_t want = std::min(ImageHandler::kImageChunk - pos, conn.imageSize - conn.imageOffset);
+    ssize_t bytesRead = 0;
+    if (want > 0) {
+        conn.out.resize(pos + want);
+        bytesRead = pread(conn.imageFd, &conn.out[pos], want, conn.imageOffset);
+        conn.out.resize(pos + (bytesRead > 0 ? bytesRead : 0));
+    }
+    if (bytesRead > 0) {
+        conn.imageOffset += bytesRead;
+    }
+    if (conn.imageOffset == conn.imageSize) {
+        serverMetrics().imagesSentBuffered++;
+        finishImage(conn);
+    } else if (bytesRead <= 0) {
+        // 바이너리 프레임이면 다음 응답이 본문 자리에 읽히므로 정상 종료로 넘기지 않는다
+        LOG_WARN("[TcpServer] Image read ended at ", conn.imageOffset, "/", conn.imageSize,
+                 " bytes, closing fd=", conn.fd);
+        return false;
+    }
+    return true;
+}
+
+// 커널이 파일을 직접 암호화해 보낸다. 1: 완료, 0: 소켓 버퍼가 참, -1: 연결 종료됨
+int EventLoop::sendImageKtls(Connection& conn) {
+    while (conn.imageOffset < conn.imageSize) {
+        ERR_clear_error();
+        ossl_ssize_t n = SSL_sendfile(conn.ssl, conn.imageFd, conn.imageOffset,
+                                      conn.imageSize - conn.imageOffset, 0);
+        if (n > 0) {
+            conn.imageOffset += n;
+            countTlsRecords(n);
+            continue;
+        }
+        if (SSL_get_error(conn.ssl, static_cast<int>(n)) == SSL_ERROR_WANT_WRITE) return 0;
+        logSslErrors();
+        closeConnection(conn);
+        return -1;
+    }
+    serverMetrics().imagesSentKtls++;
+    finishImage(conn);
+    return 1;
+}
+
+void EventLoop::finishImage(Connection& conn) {
+    serverMetrics().imageBytesSent += conn.imageOffset;
+    close(conn.imageFd);
+    conn.imageFd = -1;
+    conn.state = ConnState::Reading;  // closeAfterFlush 로 전송 후 종료
+}
+
+// 구독 대기열에서 이벤트 줄을 꺼내 out 에 붙인다. 송신이 밀려 있으면 꺼내지 않고 두어
+// 대기열이 넘치면 마지막 에러 줄을 보내고 닫는다
+void EventLoop::pumpEvents(Connection& conn) {
+    if (conn.closeAfterFlush || conn.out.size() - conn.outOffset > kOutHighWater) return;
+    std::vector<EventLine> lines;
+    bool alive = conn.subscription->take(lines);
+    for (const EventLine& line : lines) conn.out += *line;
+    serverMetrics().eventsSent += lines.size();
+    if (!alive) {
+        LOG_WARN("[TcpServer] Subscriber too slow, closing fd=", conn.fd);
+        conn.out += kSubscriberTooSlowResponse;
+        conn.out += '\n';
+        conn.closeAfterFlush = true;
+    }
+}
+
+void EventLoop::updateInterest(Connection& conn) {
+    uint32_t want = 0;
+    if (!readPaused(conn) || conn.writeWantsRead) want |= EPOLLIN;
+    if (writeDue(conn) || conn.readWantsWrite) want |= EPOLLOUT;
+    setInterest(conn, want);
+}
+
+void EventLoop::setInterest(Connection& conn, uint32_t events) {
+    if (events == conn.events) return;
+    epoll_event ev{};
+    ev.events   = events;
+    ev.data.u64 = conn.id;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, conn.fd, &ev);
+    conn.events = events;
+}
@@ -0,0 +1,41 @@
+// src/server/Frame.cpp
+
+#include "server/Frame.hpp"
+#include "util/EndianUtils.hpp"
+
+void FrameHeader::encode(char* dst) const {
+    writeBE16(dst, opcode);
+    writeBE16(dst + 2, flags);
+    writeBE32(dst + 4, requestId);
+    writeBE32(dst + 8, length);
+}
+
+FrameHeader FrameHeader::decode(const char* src) {
+    FrameHeader h;
+    h.opcode    = readBE16(src);
+    h.flags     = readBE16(src + 2);
+    h.requestId = readBE32(src + 4);
+    h.length    = readBE32(src + 8);
+    return h;
+}
+
+void appendFrame(std::string& out, uint16_t opcode, uint16_t flags, uint32_t requestId,
+                 const std::string& payload) {
+    FrameHeader h;
+    h.opcode    = opcode;
+    h.flags     = flags;
+    h.requestId = requestId;
+    h.length    = static_cast<uint32_t>(payload.size());
+
+    size_t pos = out.size();
+    out.resize(pos + FrameHeader::kSize);
+    h.encode(&out[pos]);
+    out += payload;
+}
+
+void appendJsonResponse(std::string& out, uint16_t requestOpcode, uint32_t requestId,
+                        const std::string& json) {
+    size_t len = json.size();
+    if (len > 0 && json[len - 1] == '\n') --len;
+    appendFrame(out, requestOpcode | kFrameResponse, kFrameJson, requestId, json.substr(0, len));
+}
@@ -3,15 +3,114 @@
 // =====================
 #include "../../include/server/ImageHandler.hpp"
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <utility>
 #include <vector>
-#include <iostream>
 #include <openssl/err.h>
+#include <openssl/bio.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
 #include "../../include/util/EndianUtils.hpp"
+#include "../../include/server/IoUring.hpp"
+#include "../../include/server/ReadBuffer.hpp"
+#include "../../include/server/RecordWriter.hpp"
+#include "../../include/server/ServerMetrics.hpp"
+#include "../../include/util/Logger.hpp"
+
+namespace {
+
+// 스레드마다 링 하나와 등록 버퍼 두 개 (번갈아 가며 디스크/소켓 작업)
+struct ImageRing {
+    static constexpr int kBuffers = 2;
+
+    IoUring ring{8};
+    std::vector<char> bufs[kBuffers];
+    bool ok = false;
+
+    ImageRing() {
+        if (!ring.valid()) return;
+        iovec iovs[kBuffers];
+        for (int i = 0; i < kBuffers; ++i) {
+            bufs[i].resize(ImageHandler::kImageChunk);
+            iovs[i].iov_base = bufs[i].data();
+            iovs[i].iov_len  = bufs[i].size();
+        }
+        ok = ring.registerBuffers(iovs, kBuffers);
+    }
+
+    // 버퍼 b 의 작업이 끝날 때까지 대기하고 결과 반환
+    // (아직 제출하지 않은 요청도 함께 제출)
+    int wait(int b, bool (&busy)[kBuffers], int (&res)[kBuffers]) {
+        while (true) {
+            uint64_t id;
+            int r;
+            while (ring.popCompletion(id, r)) {
+                busy[id] = false;
+                res[id] = r;
+            }
+            if (!busy[b]) break;
+            if (!ring.submitAndWait(1)) return -EIO;
+        }
+        ring.submitAndWait(0);
+        return res[b];
+    }
+};
+
+// 링을 만들 수 없으면 nullptr (기존 경로 사용)
+ImageRing* threadRing() {
+    thread_local std::unique_ptr<ImageRing> ring;
+    if (!ring) ring = std::make_unique<ImageRing>();
+    return ring->ok ? ring.get() : nullptr;
+}
+
+} // namespace
+
+UploadSession::UploadSession(UploadSession&& other) noexcept
+  : filename(std::move(other.filename)), fullPath(std::move(other.fullPath)),
+    filesize(other.filesize), received(other.received),
+    fd(std::exchange(other.fd, -1)), failed(other.failed) {}
+
+UploadSession& UploadSession::operator=(UploadSession&& other) noexcept {
+    if (this != &other) {
+        if (fd >= 0) close(fd);
+        filename = std::move(other.filename);
+        fullPath = std::move(other.fullPath);
+        filesize = other.filesize;
+        received = other.received;
+        fd       = std::exchange(other.fd, -1);
+        failed   = other.failed;
+    }
+    return *this;
+}
+
+UploadSession::~UploadSession() {
+    if (fd >= 0) close(fd);
+}
+
+void UploadSession::write(const char* data, size_t len) {
+    while (len > 0 && !failed) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            failed = true;
+            break;
+        }
+        data += n;
+        len  -= n;
+    }
+}
 
 ImageHandler::ImageHandler(sqlite3* db) : db(db) {}
 
-std::string ImageHandler::handleImageUpload(SSL* ssl, const std::string& filename, size_t filesize) {
+bool ImageHandler::setIoUring(bool enabled) {
+    useUring = enabled && IoUring::supported();
+    return useUring;
+}
+
+std::string ImageHandler::beginUpload(const std::string& filename, size_t filesize, UploadSession& session) {
     if (!std::filesystem::exists("images")) {
         std::filesystem::create_directory("images");
     }
@@ -28,66 +127,290 @@ std::string ImageHandler::handleImageUpload(SSL* ssl, const std::string& filenam
         return R"({"status":"error","code":409,"message":"File already exists"})";
     }
 
-    std::ofstream ofs(fullPath, std::ios::binary);
-    if (!ofs) {
+    session.fd = open(fullPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (session.fd < 0) {
+        if (errno == EEXIST) {
+            return R"({"status":"error","code":409,"message":"File already exists"})";
+        }
         return R"({"status":"error","code":500,"message":"Failed to open file for writing"})";
     }
+    session.failed = false;
 
-    size_t totalBytesRead = 0;
-    std::vector<char> buffer(4096);
+    session.filename = filename;
+    session.fullPath = fullPath;
+    session.filesize = filesize;
+    session.received = 0;
+    return "";
+}
 
-    while (totalBytesRead < filesize) {
-        int bytesRead = SSL_read(ssl, buffer.data(), std::min(buffer.size(), filesize - totalBytesRead));
+std::string ImageHandler::finishUpload(UploadSession& session) {
+    if (close(session.fd) < 0) session.failed = true;
+    session.fd = -1;
+    if (session.failed) {
+        std::filesystem::remove(session.fullPath);
+        return R"({"status":"error","code":500,"message":"Failed to write file completely"})";
+    }
+
+   return std::string("{\"status\":\"success\",\"code\":200,\"message\":\"Image uploaded successfully\",\"path\":\"")
+       + session.fullPath + "\"}";
+}
+
+void ImageHandler::abortUpload(UploadSession& session) {
+    if (session.fd >= 0) {
+        close(session.fd);
+        session.fd = -1;
+    }
+    if (!session.fullPath.empty()) std::filesystem::remove(session.fullPath);
+}
+
+std::string ImageHandler::handleImageUpload(SSL* ssl, const std::string& filename, size_t filesize,
+                                            ReadBuffer* buffered,
+                                            const std::function<void(size_t)>& onProgress) {
+    UploadSession session;
+    std::string err = beginUpload(filename, filesize, session);
+    if (!err.empty()) {
+        return err;
+    }
+
+    // UPLOAD 줄과 같은 레코드로 이미 도착한 본문
+    if (buffered && !buffered->empty()) {
+        size_t take = std::min(buffered->size(), filesize);
+        session.write(buffered->data(), take);
+        buffered->consume(take);
+        session.received += take;
+    }
+
+    if (useUring && threadRing()) {
+        if (!receiveUring(ssl, session, onProgress)) {
+            abortUpload(session);
+            return R"({"status":"error","code":500,"message":"Read error while receiving file"})";
+        }
+        return finishUpload(session);
+    }
+
+    std::vector<char> buffer(16 * 1024);
+
+    while (session.received < filesize) {
+        int bytesRead = SSL_read(ssl, buffer.data(), std::min(buffer.size(), filesize - session.received));
         if (bytesRead <= 0) {
-            ERR_print_errors_fp(stderr);
-            ofs.close();
-            std::filesystem::remove(fullPath);
+            logSslErrors();
+            abortUpload(session);
             return R"({"status":"error","code":500,"message":"Read error while receiving file"})";
         }
-        ofs.write(buffer.data(), bytesRead);
-        totalBytesRead += bytesRead;
+        session.write(buffer.data(), bytesRead);
+        session.received += bytesRead;
+        if (onProgress) onProgress(session.received);
     }
 
-    ofs.close();
-    if (!ofs) {
-        std::filesystem::remove(fullPath);
-        return R"({"status":"error","code":500,"message":"Failed to write file completely"})";
+    return finishUpload(session);
+}
+
+int ImageHandler::openImage(const std::string& imagePath, size_t& fileSize) {
+    int fd = open(imagePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return -1;
     }
+    fileSize = static_cast<size_t>(st.st_size);
+    return fd;
+}
 
-   return std::string("{\"status\":\"success\",\"code\":200,\"message\":\"Image uploaded successfully\",\"path\":\"")
-       + fullPath + "\"}";
+bool ImageHandler::ktlsSendEnabled(SSL* ssl) {
+    return BIO_get_ktls_send(SSL_get_wbio(ssl)) > 0;
 }
 
-void ImageHandler::handleGetImage(SSL* ssl, const std::string& imagePath) {
-    std::ifstream file(imagePath, std::ios::binary);
-    if (!file.is_open()) {
-        std::string errorMsg = R"({"status": "error", "code": 404, "message": "Image not found"})";
-        SSL_write(ssl, errorMsg.c_str(), errorMsg.size());
+void ImageHandler::handleGetImage(SSL* ssl, const std::string& imagePath, std::string prefix) {
+    serverMetrics().responsesSent++;
+    size_t fileSize = 0;
+    int fd = openImage(imagePath, fileSize);
+    if (fd < 0) {
+        prefix += R"({"status": "error", "code": 404, "message": "Image not found"})";
+        if (SSL_write(ssl, prefix.c_str(), prefix.size()) > 0) countTlsRecords(prefix.size());
         return;
     }
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
+    // 길이 헤더는 본문 첫 조각과 같은 레코드로
     uint64_t netFileSize = htonll(fileSize);
-    if (SSL_write(ssl, &netFileSize, sizeof(netFileSize)) <= 0) {
-        ERR_print_errors_fp(stderr);
-        file.close();
-        return;
+    prefix.append(reinterpret_cast<const char*>(&netFileSize), sizeof(netFileSize));
+    sendImage(ssl, fd, fileSize, prefix);
+    close(fd);
+}
+
+bool ImageHandler::sendImage(SSL* ssl, int fd, size_t fileSize, const std::string& prefix) {
+    bool ktls = ktlsSendEnabled(ssl);
+    // 본문 조각에 붙일 수 없으면 (kTLS, 빈 파일, 너무 긴 앞부분) 따로 보낸다
+    bool separate = ktls || fileSize == 0 || prefix.size() > kImageChunk / 2;
+    if (separate && !prefix.empty()) {
+        if (SSL_write(ssl, prefix.data(), static_cast<int>(prefix.size())) <= 0) {
+            logSslErrors();
+            return false;
+        }
+        countTlsRecords(prefix.size());
+    }
+    const std::string_view head = separate ? std::string_view() : std::string_view(prefix);
+    if (ktls) {
+        return sendFileKtls(ssl, fd, fileSize);
+    }
+    if (useUring && threadRing()) {
+        return sendFileUring(ssl, fd, fileSize, head);
     }
+    return sendFileBuffered(ssl, fd, fileSize, head);
+}
+
+// 커널이 페이지 캐시에서 바로 암호화해 보내므로 유저 공간 복사가 없다
+bool ImageHandler::sendFileKtls(SSL* ssl, int fd, size_t fileSize) {
+    off_t offset = 0;
+    while (static_cast<size_t>(offset) < fileSize) {
+        ossl_ssize_t sent = SSL_sendfile(ssl, fd, offset, fileSize - offset, 0);
+        if (sent <= 0) {
+            logSslErrors();
+            return false;
+        }
+        offset += sent;
+        countTlsRecords(sent);
+    }
+    serverMetrics().imagesSentKtls++;
+    serverMetrics().imageBytesSent += fileSize;
+    return true;
+}
 
-    char buffer[4096];
-    while (!file.eof()) {
-        file.read(buffer, sizeof(buffer));
-        std::streamsize bytesRead = file.gcount();
-        if (bytesRead > 0) {
-            if (SSL_write(ssl, buffer, bytesRead) <= 0) {
-                ERR_print_errors_fp(stderr);
+bool ImageHandler::sendFileBuffered(SSL* ssl, int fd, size_t fileSize, std::string_view head) {
+    std::vector<char> buffer(kImageChunk);
+    size_t sentTotal = 0;
+    while (sentTotal < fileSize) {
+        // 첫 조각은 head 뒤에 이어 읽어 SSL_write 가 꽉 찬 레코드를 만들게 한다
+        if (!head.empty()) memcpy(buffer.data(), head.data(), head.size());
+        size_t want = std::min(buffer.size() - head.size(), fileSize - sentTotal);
+        ssize_t bytesRead = read(fd, buffer.data() + head.size(), want);
+        if (bytesRead <= 0) break;  // 전송 중 파일이 줄어든 경우
+        size_t len = head.size() + bytesRead;
+        if (SSL_write(ssl, buffer.data(), static_cast<int>(len)) <= 0) {
+            logSslErrors();
+            return false;
+        }
+        countTlsRecords(len);
+        sentTotal += bytesRead;
+        head = {};
+    }
+    serverMetrics().imagesSentBuffered++;
+    serverMetrics().imageBytesSent += sentTotal;
+    return sentTotal == fileSize;
+}
+
+// 버퍼 두 개를 번갈아: 한쪽을 SSL_write 하는 동안 다른 쪽으로 다음 조각을 읽어 둔다
+bool ImageHandler::sendFileUring(SSL* ssl, int fd, size_t fileSize, std::string_view head) {
+    ImageRing& r = *threadRing();
+    bool   busy[ImageRing::kBuffers]    = {false, false};  // 커널 작업 진행 중
+    bool   queued[ImageRing::kBuffers]  = {false, false};  // 읽기를 요청했고 아직 보내지 않음
+    int    res[ImageRing::kBuffers]     = {0, 0};
+    size_t offset[ImageRing::kBuffers]  = {0, 0};          // 버퍼별로 요청한 파일 위치와 길이
+    size_t request[ImageRing::kBuffers] = {0, 0};
+    size_t readOffset = 0;
+    size_t sentTotal  = 0;
+
+    // 첫 조각은 head 를 버퍼 앞에 두고 그 뒤로 읽는다
+    size_t headLen[ImageRing::kBuffers] = {head.size(), 0};
+    if (!head.empty()) memcpy(r.bufs[0].data(), head.data(), head.size());
+
+    auto readAhead = [&](int b) {
+        if (readOffset >= fileSize) return;
+        unsigned len = static_cast<unsigned>(std::min(kImageChunk - headLen[b], fileSize - readOffset));
+        if (!r.ring.prepReadFixed(fd, r.bufs[b].data() + headLen[b], len, readOffset, b, b)) return;
+        busy[b] = queued[b] = true;
+        offset[b] = readOffset;
+        request[b] = len;
+        readOffset += len;
+    };
+
+    readAhead(0);
+    bool ok = true;
+    for (int cur = 0; queued[cur]; cur ^= 1) {
+        // 다음 조각 읽기 제출과 현재 조각 완료 대기를 io_uring_enter 한 번으로
+        readAhead(cur ^ 1);
+        int n = r.wait(cur, busy, res);
+        queued[cur] = false;
+        if (n <= 0) {
+            // 끝까지 읽기 전에 0 이면 전송 중 파일이 줄어든 것
+            LOG_ERROR("Image read failed at offset ", offset[cur], " of ", fileSize, ": ", n);
+            ok = false;
+            break;
+        }
+        size_t len = headLen[cur] + n;
+        headLen[cur] = 0;
+        if (SSL_write(ssl, r.bufs[cur].data(), static_cast<int>(len)) <= 0) {
+            logSslErrors();
+            ok = false;
+            break;
+        }
+        countTlsRecords(len);
+        sentTotal += n;
+
+        if (static_cast<size_t>(n) < request[cur]) {
+            // 짧은 읽기: 뒤 조각의 선읽기는 빈 구간 다음부터라 버리고, 실제로 읽은 끝에서 다시 요청한다
+            int other = cur ^ 1;
+            r.wait(other, busy, res);
+            queued[other] = false;
+            readOffset = offset[cur] + n;
+            readAhead(other);
+        }
+    }
+    // 진행 중인 선읽기가 끝나야 버퍼를 다시 쓸 수 있다
+    for (int b = 0; b < ImageRing::kBuffers; ++b) r.wait(b, busy, res);
+
+    serverMetrics().imagesSentUring++;
+    serverMetrics().imageBytesSent += sentTotal;
+    return ok && sentTotal == fileSize;
+}
+
+// 한 버퍼를 SSL_read 로 채우는 동안 다른 버퍼는 커널이 파일에 쓴다
+bool ImageHandler::receiveUring(SSL* ssl, UploadSession& session,
+                                const std::function<void(size_t)>& onProgress) {
+    ImageRing& r = *threadRing();
+    bool   busy[ImageRing::kBuffers] = {false, false};
+    int    res[ImageRing::kBuffers]  = {0, 0};
+    size_t queuedLen[ImageRing::kBuffers] = {0, 0};
+    size_t fileOffset = session.received;  // 버퍼에 있던 앞부분은 이미 썼다
+
+    auto reap = [&](int b) {
+        if (!busy[b] && queuedLen[b] == 0) return;
+        if (r.wait(b, busy, res) != static_cast<int>(queuedLen[b])) session.failed = true;
+        queuedLen[b] = 0;
+    };
+
+    bool ok = true;
+    for (int cur = 0; session.received < session.filesize && ok; cur ^= 1) {
+        reap(cur);
+        size_t want = std::min(kImageChunk, session.filesize - session.received);
+        size_t filled = 0;
+        while (filled < want) {
+            int n = SSL_read(ssl, r.bufs[cur].data() + filled, static_cast<int>(want - filled));
+            if (n <= 0) {
+                logSslErrors();
+                ok = false;
                 break;
             }
+            filled += n;
+            session.received += n;
+            if (onProgress) onProgress(session.received);
         }
+        if (!ok) break;
+
+        if (!r.ring.prepWriteFixed(session.fd, r.bufs[cur].data(), static_cast<unsigned>(filled),
+                                   fileOffset, cur, cur) ||
+            !r.ring.submitAndWait(0)) {
+            session.failed = true;
+            ok = false;
+            break;
+        }
+        busy[cur] = true;
+        queuedLen[cur] = filled;
+        fileOffset += filled;
     }
+    for (int b = 0; b < ImageRing::kBuffers; ++b) reap(b);
 
-    file.close();
-}
\ No newline at end of file
+    if (ok) serverMetrics().uploadsUring++;
+    return ok;
+}
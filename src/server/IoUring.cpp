@@ -0,0 +1,183 @@
+// src/server/IoUring.cpp
+
+#include "server/IoUring.hpp"
+
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#ifdef HAVE_IO_URING
+
+namespace {
+
+int sysSetup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int sysRegister(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+template <typename T>
+T* at(void* base, unsigned offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+bool IoUring::supported() {
+    // seccomp, io_uring_disabled sysctl, 오래된 커널 모두 setup 실패로 드러난다
+    static const bool ok = [] {
+        IoUring probe(2);
+        return probe.valid();
+    }();
+    return ok;
+}
+
+IoUring::IoUring(unsigned entries)
+  : ringFd(-1), sqRing(MAP_FAILED), cqRing(MAP_FAILED), sqRingSize(0), cqRingSize(0),
+    sqes(static_cast<io_uring_sqe*>(MAP_FAILED)), sqesSize(0), pending(0) {
+    io_uring_params p{};
+    int fd = sysSetup(entries, &p);
+    if (fd < 0) return;
+
+    sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  fd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+    cqRing = single ? sqRing
+                    : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           fd, IORING_OFF_CQ_RING);
+    sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    void* s = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_SQES);
+    if (cqRing == MAP_FAILED || s == MAP_FAILED) {
+        if (s != MAP_FAILED) munmap(s, sqesSize);
+        if (!single && cqRing != MAP_FAILED) munmap(cqRing, cqRingSize);
+        munmap(sqRing, sqRingSize);
+        sqRing = cqRing = MAP_FAILED;
+        close(fd);
+        return;
+    }
+    sqes = static_cast<io_uring_sqe*>(s);
+
+    sqHead  = at<unsigned>(sqRing, p.sq_off.head);
+    sqTail  = at<unsigned>(sqRing, p.sq_off.tail);
+    sqMask  = at<unsigned>(sqRing, p.sq_off.ring_mask);
+    sqArray = at<unsigned>(sqRing, p.sq_off.array);
+    cqHead  = at<unsigned>(cqRing, p.cq_off.head);
+    cqTail  = at<unsigned>(cqRing, p.cq_off.tail);
+    cqMask  = at<unsigned>(cqRing, p.cq_off.ring_mask);
+    cqes    = at<io_uring_cqe>(cqRing, p.cq_off.cqes);
+    ringFd  = fd;
+}
+
+IoUring::~IoUring() {
+    if (ringFd < 0) return;
+    munmap(sqes, sqesSize);
+    if (cqRing != sqRing) munmap(cqRing, cqRingSize);
+    munmap(sqRing, sqRingSize);
+    close(ringFd);
+}
+
+bool IoUring::registerBuffers(const iovec* iovs, unsigned count) {
+    return sysRegister(ringFd, IORING_REGISTER_BUFFERS, iovs, count) == 0;
+}
+
+io_uring_sqe* IoUring::nextSqe() {
+    unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    unsigned tail = *sqTail + pending;
+    if (tail - head > *sqMask) return nullptr;
+
+    unsigned idx = tail & *sqMask;
+    io_uring_sqe* sqe = &sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[idx] = idx;
+    pending++;
+    return sqe;
+}
+
+bool IoUring::prepReadFixed(int fd, void* buf, unsigned len, uint64_t offset, int bufIndex, uint64_t userData) {
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) return false;
+    sqe->opcode    = IORING_OP_READ_FIXED;
+    sqe->fd        = fd;
+    sqe->addr      = reinterpret_cast<uint64_t>(buf);
+    sqe->len       = len;
+    sqe->off       = offset;
+    sqe->buf_index = static_cast<uint16_t>(bufIndex);
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::prepWriteFixed(int fd, const void* buf, unsigned len, uint64_t offset, int bufIndex, uint64_t userData) {
+    io_uring_sqe* sqe = nextSqe();
+    if (!sqe) return false;
+    sqe->opcode    = IORING_OP_WRITE_FIXED;
+    sqe->fd        = fd;
+    sqe->addr      = reinterpret_cast<uint64_t>(buf);
+    sqe->len       = len;
+    sqe->off       = offset;
+    sqe->buf_index = static_cast<uint16_t>(bufIndex);
+    sqe->user_data = userData;
+    return true;
+}
+
+bool IoUring::submitAndWait(unsigned waitFor) {
+    unsigned toSubmit = pending;
+    if (toSubmit > 0) {
+        // 커널이 SQE 를 보기 전에 내용이 모두 기록되어 있어야 한다
+        __atomic_store_n(sqTail, *sqTail + toSubmit, __ATOMIC_RELEASE);
+        pending = 0;
+    }
+    if (toSubmit == 0 && waitFor == 0) return true;
+
+    while (true) {
+        int ret = sysEnter(ringFd, toSubmit, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0);
+        if (ret >= 0) return true;
+        if (errno != EINTR) return false;
+        toSubmit = 0;  // EINTR 이면 제출은 이미 끝났을 수 있으므로 대기만 다시
+    }
+}
+
+bool IoUring::popCompletion(uint64_t& userData, int& res) {
+    unsigned head = *cqHead;
+    if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) return false;
+
+    const io_uring_cqe& cqe = cqes[head & *cqMask];
+    userData = cqe.user_data;
+    res      = cqe.res;
+    __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+#else  // io_uring 헤더가 없는 빌드: 항상 기존 경로 사용
+
+bool IoUring::supported() { return false; }
+IoUring::IoUring(unsigned) : ringFd(-1), pending(0) {}
+IoUring::~IoUring() {}
+bool IoUring::registerBuffers(const iovec*, unsigned) { return false; }
+bool IoUring::prepReadFixed(int, void*, unsigned, uint64_t, int, uint64_t) { return false; }
+bool IoUring::prepWriteFixed(int, const void*, unsigned, uint64_t, int, uint64_t) { return false; }
+bool IoUring::submitAndWait(unsigned) { return false; }
+bool IoUring::popCompletion(uint64_t&, int&) { return false; }
+
+#endif
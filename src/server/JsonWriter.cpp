@@ -0,0 +1,149 @@
+// src/server/JsonWriter.cpp
+
+#include <charconv>
+#include <cmath>
+
+#include <json.hpp> // dump() 와 같은 실수 표기 (Grisu2)
+
+#include "server/JsonWriter.hpp"
+
+namespace {
+
+// 다음 UTF-8 문자의 바이트 수 (RFC 3629, 과잉 표현과 서로게이트 제외). 잘못됐으면 0
+size_t utf8Length(std::string_view s, size_t i) {
+    auto at = [&](size_t k) { return static_cast<unsigned char>(s[k]); };
+    auto cont = [&](size_t k, unsigned char lo = 0x80, unsigned char hi = 0xBF) {
+        return k < s.size() && at(k) >= lo && at(k) <= hi;
+    };
+    unsigned char c = at(i);
+    if (c >= 0xC2 && c <= 0xDF) return cont(i + 1) ? 2 : 0;
+    if (c == 0xE0) return cont(i + 1, 0xA0) && cont(i + 2) ? 3 : 0;
+    if ((c >= 0xE1 && c <= 0xEC) || c == 0xEE || c == 0xEF) return cont(i + 1) && cont(i + 2) ? 3 : 0;
+    if (c == 0xED) return cont(i + 1, 0x80, 0x9F) && cont(i + 2) ? 3 : 0;
+    if (c == 0xF0) return cont(i + 1, 0x90) && cont(i + 2) && cont(i + 3) ? 4 : 0;
+    if (c >= 0xF1 && c <= 0xF3) return cont(i + 1) && cont(i + 2) && cont(i + 3) ? 4 : 0;
+    if (c == 0xF4) return cont(i + 1, 0x80, 0x8F) && cont(i + 2) && cont(i + 3) ? 4 : 0;
+    return 0;
+}
+
+} // namespace
+
+void JsonWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (depth == 0) return;
+    if (!first[depth - 1]) out.push_back(',');
+    first[depth - 1] = false;
+}
+
+void JsonWriter::beginObject() {
+    separate();
+    out.push_back('{');
+    first[depth++] = true;
+}
+
+void JsonWriter::endObject() {
+    --depth;
+    out.push_back('}');
+}
+
+void JsonWriter::beginArray() {
+    separate();
+    out.push_back('[');
+    first[depth++] = true;
+}
+
+void JsonWriter::endArray() {
+    --depth;
+    out.push_back(']');
+}
+
+void JsonWriter::key(std::string_view name) {
+    separate();
+    escape(name);
+    out.push_back(':');
+    afterKey = true;
+}
+
+void JsonWriter::value(std::string_view s) {
+    separate();
+    escape(s);
+}
+
+void JsonWriter::value(int64_t n) {
+    separate();
+    char buf[24];
+    auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), n);
+    out.append(buf, end);
+}
+
+void JsonWriter::value(double x) {
+    separate();
+    if (!std::isfinite(x)) {
+        out.append("null");
+        return;
+    }
+    char buf[64];
+    char* end = nlohmann::detail::to_chars(buf, buf + sizeof(buf), x);
+    out.append(buf, end);
+}
+
+void JsonWriter::value(bool b) {
+    separate();
+    out.append(b ? "true" : "false");
+}
+
+void JsonWriter::null() {
+    separate();
+    out.append("null");
+}
+
+void JsonWriter::raw(std::string_view json) {
+    separate();
+    out.append(json);
+}
+
+// dump() 의 이스케이프: " \ 와 0x1F 이하 제어 문자만 (\b \t \n \f \r, 나머지는 \u00xx),
+// 멀티바이트 UTF-8 은 검사만 하고 그대로
+void JsonWriter::escape(std::string_view s) {
+    out.push_back('"');
+    size_t run = 0;  // 그대로 복사할 구간의 시작
+    size_t i = 0;
+    while (i < s.size()) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x80) {
+            size_t len = utf8Length(s, i);
+            if (len == 0) {
+                valid = false;
+                out.push_back('"');
+                return;
+            }
+            i += len;
+            continue;
+        }
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            ++i;
+            continue;
+        }
+        out.append(s.data() + run, i - run);
+        switch (c) {
+            case '"':  out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\t': out.append("\\t"); break;
+            case '\n': out.append("\\n"); break;
+            case '\f': out.append("\\f"); break;
+            case '\r': out.append("\\r"); break;
+            default: {
+                static constexpr char hex[] = "0123456789abcdef";
+                char esc[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                out.append(esc, sizeof(esc));
+            }
+        }
+        run = ++i;
+    }
+    out.append(s.data() + run, s.size() - run);
+    out.push_back('"');
+}
@@ -0,0 +1,183 @@
+// src/server/ListenerHandoff.cpp
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "server/ListenerHandoff.hpp"
+#include "util/Logger.hpp"
+
+namespace {
+
+constexpr const char kRequest[] = "TAKEOVER\n";
+constexpr size_t kMaxFds = 64;
+
+bool makeAddress(const std::string& path, sockaddr_un& addr) {
+    if (path.size() >= sizeof(addr.sun_path)) {
+        LOG_WARN("[Handoff] Socket path too long: ", path);
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+} // namespace
+
+std::vector<int> ListenerHandoff::receive(const std::string& path) {
+    std::vector<int> fds;
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) return fds;
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) return fds;
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        // 실행 중인 서버 없음: 평소처럼 새로 bind
+        close(sock);
+        return fds;
+    }
+    if (write(sock, kRequest, sizeof(kRequest) - 1) != static_cast<ssize_t>(sizeof(kRequest) - 1)) {
+        close(sock);
+        return fds;
+    }
+
+    char count = 0;
+    iovec iov{&count, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFds)];
+    msghdr msg{};
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+    } while (n < 0 && errno == EINTR);
+
+    if (n == 1) {
+        for (cmsghdr* c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c)) {
+            if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_RIGHTS) continue;
+            size_t got = (c->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t i = 0; i < got; ++i) {
+                int fd;
+                memcpy(&fd, CMSG_DATA(c) + i * sizeof(int), sizeof(int));
+                fds.push_back(fd);
+            }
+        }
+    }
+    if (fds.size() != static_cast<size_t>(static_cast<unsigned char>(count))) {
+        LOG_WARN("[Handoff] Incomplete handoff from ", path, ", binding fresh");
+        for (int fd : fds) close(fd);
+        fds.clear();
+    }
+
+    // 기존 서버가 path 를 지우고 연결을 닫을 때까지 기다린다 (이후 같은 path 에 listen 가능)
+    char c;
+    ssize_t r;
+    while ((r = read(sock, &c, 1)) > 0 || (r < 0 && errno == EINTR)) {}
+    close(sock);
+    return fds;
+}
+
+int ListenerHandoff::listen(const std::string& path) {
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) return -1;
+
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        logErrno("socket(AF_UNIX)");
+        return -1;
+    }
+    // 이전 프로세스가 비정상 종료하며 남긴 소켓 파일
+    unlink(path.c_str());
+    // 리스너를 가져갈 수 있는 것은 같은 사용자뿐: 소켓 파일을 처음부터 0600 으로 만들고,
+    // listen 전에 권한을 한 번 더 확정한다 (listen 전에는 아무도 접속할 수 없다)
+    mode_t oldMask = umask(0077);
+    int bound = bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    umask(oldMask);
+    if (bound < 0) {
+        logErrno("bind(handoff)");
+        close(sock);
+        return -1;
+    }
+    if (chmod(path.c_str(), 0600) < 0) {
+        logErrno("chmod(handoff)");
+        close(sock);
+        unlink(path.c_str());
+        return -1;
+    }
+    if (::listen(sock, 4) < 0) {
+        logErrno("listen(handoff)");
+        close(sock);
+        unlink(path.c_str());
+        return -1;
+    }
+    return sock;
+}
+
+bool ListenerHandoff::serve(int handoffFd, const std::string& path, const std::vector<int>& fds) {
+    if (fds.empty() || fds.size() > kMaxFds) return false;
+
+    while (true) {
+        int conn = accept4(handoffFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (conn < 0) {
+            if (errno == EINTR) continue;
+            logErrno("accept(handoff)");
+            return false;
+        }
+
+        // 소켓 파일 권한과 별개로 접속자도 확인한다
+        ucred cred{};
+        socklen_t len = sizeof(cred);
+        if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0) {
+            logErrno("getsockopt(SO_PEERCRED)");
+            close(conn);
+            continue;
+        }
+        if (cred.uid != geteuid()) {
+            LOG_WARN("[Handoff] Rejected takeover from uid=", cred.uid, " pid=", cred.pid);
+            close(conn);
+            continue;
+        }
+
+        char req[sizeof(kRequest)] = {};
+        ssize_t n = read(conn, req, sizeof(kRequest) - 1);
+        if (n != static_cast<ssize_t>(sizeof(kRequest) - 1) || memcmp(req, kRequest, n) != 0) {
+            close(conn);
+            continue;
+        }
+
+        char count = static_cast<char>(fds.size());
+        iovec iov{&count, 1};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kMaxFds)];
+        memset(control, 0, sizeof(control));
+        msghdr msg{};
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        cmsghdr* c = CMSG_FIRSTHDR(&msg);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type  = SCM_RIGHTS;
+        c->cmsg_len   = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(c), fds.data(), sizeof(int) * fds.size());
+
+        if (sendmsg(conn, &msg, MSG_NOSIGNAL) != 1) {
+            logErrno("sendmsg(handoff)");
+            close(conn);
+            continue;
+        }
+
+        // path 를 비운 뒤에 연결을 닫아야 새 서버가 같은 path 로 listen 할 수 있다
+        unlink(path.c_str());
+        close(handoffFd);
+        close(conn);
+        return true;
+    }
+}
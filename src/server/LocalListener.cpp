@@ -0,0 +1,334 @@
+// src/server/LocalListener.cpp
+
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "server/LocalListener.hpp"
+#include "server/TcpServer.hpp"
+#include "server/CommandHandler.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/CommandTable.hpp"
+#include "server/ConnectionWatchdog.hpp"
+#include "server/EventBroadcaster.hpp"
+#include "server/ImageHandler.hpp"
+#include "server/ReadBuffer.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/EndianUtils.hpp"
+#include "util/Logger.hpp"
+
+namespace {
+
+// 블로킹 소켓에 전부 쓴다. 상대가 닫았으면 false (SIGPIPE 없이)
+bool writeAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len  -= n;
+    }
+    return true;
+}
+
+} // namespace
+
+LocalListener::LocalListener(TcpServer* server) : server(server) {}
+
+LocalListener::~LocalListener() {
+    if (listenFd >= 0) close(listenFd);
+}
+
+bool LocalListener::open(const std::string& path, int mode) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        LOG_WARN("[LocalListener] Socket path too long: ", path);
+        return false;
+    }
+    memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    // 이전 서버가 남긴 소켓 파일만 지운다 (일반 파일은 건드리지 않음)
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        logErrno("socket(AF_UNIX)");
+        return false;
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        logErrno("bind(local)");
+        close(fd);
+        return false;
+    }
+    // umask 와 무관하게 권한을 맞춘다 (접속에는 쓰기 권한이 필요)
+    if (chmod(path.c_str(), static_cast<mode_t>(mode)) < 0) {
+        logErrno("chmod(local)");
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+    if (::listen(fd, server->getConfig().backlog) < 0) {
+        logErrno("listen(local)");
+        close(fd);
+        unlink(path.c_str());
+        return false;
+    }
+    listenFd = fd;
+    LOG_INFO("[LocalListener] Listening on ", path);
+    return true;
+}
+
+void LocalListener::start() {
+    if (listenFd < 0) return;
+    std::thread([this] { acceptLoop(); }).detach();
+}
+
+void LocalListener::drain() {
+    draining = true;
+    // 막혀 있는 accept() 를 깨운다. 경로는 새 서버의 소켓이므로 지우지 않는다
+    if (listenFd >= 0) shutdown(listenFd, SHUT_RDWR);
+}
+
+bool LocalListener::peerAllowed(int fd, int allowUid, pid_t& pid, uid_t& uid) {
+    ucred cred{};
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) < 0) {
+        logErrno("getsockopt(SO_PEERCRED)");
+        return false;
+    }
+    pid = cred.pid;
+    uid = cred.uid;
+    return uid == 0 || uid == geteuid() ||
+           (allowUid >= 0 && uid == static_cast<uid_t>(allowUid));
+}
+
+void LocalListener::acceptLoop() {
+    ServerMetrics& m = serverMetrics();
+    int allowUid = server->getConfig().localAllowUid;
+    while (!draining) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (!draining) logErrno("accept(local)");
+            break;
+        }
+
+        pid_t pid = 0;
+        uid_t uid = 0;
+        if (!peerAllowed(fd, allowUid, pid, uid)) {
+            m.localRejected++;
+            LOG_WARN("[LocalListener] Rejected peer pid=", pid, " uid=", uid);
+            close(fd);
+            continue;
+        }
+        if (!server->admitConnection()) {
+            LOG_WARN("[LocalListener] Connection limit reached, rejecting fd=", fd);
+            close(fd);
+            continue;
+        }
+        m.localConnections++;
+        LOG_INFO("[LocalListener] Connection fd=", fd, " pid=", pid, " uid=", uid);
+
+        std::thread([this, fd] {
+            serve(fd);
+            // 호출자가 fd 를 닫기 전에 감시 해제
+            if (ConnectionWatchdog* watchdog = server->getWatchdog()) watchdog->disarm(fd);
+            close(fd);
+            server->releaseConnection();
+        }).detach();
+    }
+    close(listenFd);
+    listenFd = -1;
+}
+
+void LocalListener::serve(int fd) {
+    const ServerConfig& config = server->getConfig();
+    ConnectionWatchdog* watchdog = server->getWatchdog();
+    ImageHandler* imageHandler = server->getImageHandler();
+
+    // 블로킹 read 가 멈춰 있으면 감시 스레드가 shutdown(fd) 으로 깨운다
+    TimeoutKind armed = TimeoutKind::None;
+    auto arm = [&](TimeoutKind kind, int timeoutMs, bool betweenRequests = false) {
+        armed = kind;
+        if (watchdog) watchdog->arm(fd, kind, timeoutMs, betweenRequests);
+    };
+
+    ReadBuffer rbuf;
+    std::string out;  // 처리할 줄이 더 없을 때 한 번에 보낸다
+    auto flush = [&] {
+        bool ok = writeAll(fd, out.data(), out.size());
+        out.clear();
+        return ok;
+    };
+    auto append = [&](std::string resp) {
+        if (resp.empty() || resp.back() != '\n') resp.push_back('\n');
+        out += resp;
+    };
+
+    bool served = false;
+    while (true) {
+        size_t lineLen;
+        while ((lineLen = rbuf.findLine()) == 0) {
+            if (!flush()) return;
+            if (rbuf.size() > ReadBuffer::kMaxLineLength) {
+                LOG_WARN("[LocalListener] Line too long, closing fd=", fd);
+                return;
+            }
+            // 줄을 받기 시작한 뒤로는 바이트가 와도 연장하지 않는다
+            if (rbuf.empty()) {
+                arm(TimeoutKind::Idle, config.idleTimeoutMs, served);
+            } else if (armed != TimeoutKind::Header) {
+                arm(TimeoutKind::Header, config.headerTimeoutMs);
+            }
+            char* dst = rbuf.prepareWrite();
+            ssize_t n = read(fd, dst, rbuf.writable());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;
+            rbuf.commit(static_cast<size_t>(n));
+        }
+        std::string cmd(rbuf.data(), lineLen);
+        rbuf.consume(lineLen);
+        arm(TimeoutKind::Idle, config.idleTimeoutMs);
+
+        if (cmd == "\n") continue;
+        LOG_INFO("[LocalListener] Received: ", cmd);
+        served = true;
+        CommandId command = commandId(cmd);
+
+        if (command == CommandId::Upload && imageHandler) {
+            std::string_view filename;
+            size_t filesize = 0;
+            if (!parseArgs(commandArgs(cmd), 2, filename, filesize)) filesize = 0;
+
+            if (filename.empty() || filesize == 0) {
+                append(R"({"status":"error","code":400,"message":"Invalid filename or filesize"})");
+            } else {
+                if (!flush()) return;
+                arm(TimeoutKind::Upload, config.uploadTimeoutMs);
+                std::string result = receiveUpload(fd, rbuf, std::string(filename), filesize);
+                if (result.empty()) return;
+                arm(TimeoutKind::Idle, config.idleTimeoutMs);
+                append(std::move(result));
+            }
+        } else if (command == CommandId::GetImage && imageHandler) {
+            // TLS 연결과 같이 이미지를 보낸 뒤 연결을 닫는다
+            std::string_view imagePath;
+            if (!parseArgs(commandArgs(cmd), 1, imagePath)) imagePath = {};
+            if (imagePath.empty()) {
+                out += R"({"status": "error", "code": 400, "message": "Missing image path"})";
+                flush();
+                return;
+            }
+            sendImage(fd, std::string(imagePath), out);
+            return;
+        } else if (command == CommandId::SubscribeEvents) {
+            int eventType;
+            if (!parseSubscribe(cmd, eventType)) {
+                append(R"({"status": "error", "code": 400, "message": "Invalid event type"})");
+                continue;
+            }
+            if (!flush()) return;
+            // 이벤트를 기다리는 동안에는 제한 시간 없이 유지하고 (드레인 때는 닫는다),
+            // 보내는 동안에만 유휴 제한 시간으로 못 읽는 구독자를 끊는다
+            arm(TimeoutKind::Idle, 0, true);
+            streamEvents(fd, eventType,
+                         [&](std::string_view data) {
+                             arm(TimeoutKind::Idle, config.idleTimeoutMs);
+                             bool ok = writeAll(fd, data.data(), data.size());
+                             arm(TimeoutKind::Idle, 0, true);
+                             return ok;
+                         },
+                         [fd] {
+                             char discard[512];
+                             return read(fd, discard, sizeof(discard)) > 0;
+                         });
+            return;
+        } else if (command == CommandId::Proto) {
+            std::string_view mode;
+            if (!parseArgs(commandArgs(cmd), 1, mode)) mode = {};
+            append(mode == "TEXT"
+                       ? R"({"status": "success", "code": 200, "message": "Text protocol"})"
+                       : R"({"status": "error", "code": 400, "message": "Unknown protocol"})");
+        } else if (CommandHandler::isReadOnly(cmd)) {
+            // 이미 도착해 있는 뒤따르는 조회 명령을 함께 실행하고 요청 순서대로 응답
+            std::vector<std::string> batch{cmd};
+            while (batch.size() < static_cast<size_t>(config.pipelineDepth) &&
+                   (lineLen = rbuf.findLine()) > 0) {
+                std::string next(rbuf.data(), lineLen);
+                if (!CommandHandler::isReadOnly(next)) break;
+                rbuf.consume(lineLen);
+                LOG_INFO("[LocalListener] Received: ", next);
+                batch.push_back(std::move(next));
+            }
+            for (std::string& resp : server->executeCommands(batch)) append(std::move(resp));
+        } else {
+            append(server->executeCommand(cmd));
+        }
+    }
+}
+
+std::string LocalListener::receiveUpload(int fd, ReadBuffer& rbuf, const std::string& filename,
+                                         size_t filesize) {
+    ImageHandler* imageHandler = server->getImageHandler();
+    const ServerConfig& config = server->getConfig();
+    ConnectionWatchdog* watchdog = server->getWatchdog();
+
+    UploadSession session;
+    std::string err = imageHandler->beginUpload(filename, filesize, session);
+    if (!err.empty()) return err;
+
+    // UPLOAD 줄과 함께 이미 도착한 본문
+    size_t take = std::min(rbuf.size(), filesize);
+    session.write(rbuf.data(), take);
+    rbuf.consume(take);
+    session.received = take;
+
+    std::vector<char> buffer(ImageHandler::kImageChunk);
+    while (session.received < filesize) {
+        ssize_t n = read(fd, buffer.data(), std::min(buffer.size(), filesize - session.received));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            imageHandler->abortUpload(session);
+            return {};
+        }
+        session.write(buffer.data(), static_cast<size_t>(n));
+        session.received += static_cast<size_t>(n);
+        if (watchdog) watchdog->arm(fd, TimeoutKind::Upload, config.uploadTimeoutMs);
+    }
+    return imageHandler->finishUpload(session);
+}
+
+void LocalListener::sendImage(int fd, const std::string& imagePath, std::string& pending) {
+    size_t fileSize = 0;
+    int imageFd = ImageHandler::openImage(imagePath, fileSize);
+    if (imageFd < 0) {
+        pending += R"({"status": "error", "code": 404, "message": "Image not found"})";
+        writeAll(fd, pending.data(), pending.size());
+        return;
+    }
+
+    uint64_t netFileSize = htonll(fileSize);
+    pending.append(reinterpret_cast<const char*>(&netFileSize), sizeof(netFileSize));
+    bool ok = writeAll(fd, pending.data(), pending.size());
+
+    // 평문이므로 페이지 캐시에서 소켓으로 바로 보낸다
+    off_t offset = 0;
+    while (ok && static_cast<size_t>(offset) < fileSize) {
+        ssize_t n = sendfile(fd, imageFd, &offset, fileSize - offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) ok = false;
+    }
+    close(imageFd);
+    if (ok) serverMetrics().imageBytesSent += fileSize;
+}
@@ -0,0 +1,53 @@
+// src/server/ReadBuffer.cpp
+
+#include <cstring>
+
+#include "server/ReadBuffer.hpp"
+
+ReadBuffer::ReadBuffer(size_t capacity)
+  : buf(capacity), rpos(0), wpos(0), scanned(0) {}
+
+size_t ReadBuffer::findLine() {
+    if (scanned == size()) return 0;
+    const char* begin = buf.data() + rpos;
+    const void* nl = memchr(begin + scanned, '\n', size() - scanned);
+    if (!nl) {
+        scanned = size();
+        return 0;
+    }
+    return static_cast<const char*>(nl) - begin + 1;
+}
+
+void ReadBuffer::consume(size_t n) {
+    rpos += n;
+    scanned = scanned > n ? scanned - n : 0;
+    if (rpos == wpos) {
+        rpos = wpos = 0;
+    }
+}
+
+size_t ReadBuffer::take(char* dst, size_t n) {
+    size_t len = n < size() ? n : size();
+    memcpy(dst, data(), len);
+    consume(len);
+    return len;
+}
+
+char* ReadBuffer::prepareWrite(size_t minSpace) {
+    if (writable() < minSpace && rpos > 0) {
+        // 소비된 앞부분을 당겨 공간 확보
+        memmove(buf.data(), buf.data() + rpos, size());
+        wpos -= rpos;
+        rpos = 0;
+    }
+    if (writable() < minSpace) {
+        buf.resize(wpos + minSpace);
+    }
+    return buf.data() + wpos;
+}
+
+void ReadBuffer::release() {
+    if (!empty()) return;
+    std::vector<char>().swap(buf);
+    rpos = wpos = scanned = 0;
+}
@@ -0,0 +1,41 @@
+// src/server/RecordWriter.cpp
+
+#include <openssl/err.h>
+#include <cstdio>
+#include <utility>
+
+#include "server/RecordWriter.hpp"
+#include "util/Logger.hpp"
+
+bool RecordWriter::append(const char* data, size_t len) {
+    if (error) return false;
+    serverMetrics().responsesSent++;
+    buf.append(data, len);
+    // 꽉 찬 레코드만 보내고 자투리는 다음 응답과 합친다
+    size_t full = buf.size() - buf.size() % kTlsRecordSize;
+    return full == 0 || send(full);
+}
+
+bool RecordWriter::flush() {
+    if (error) return false;
+    return buf.empty() || send(buf.size());
+}
+
+std::string RecordWriter::take() {
+    std::string pending;
+    pending.swap(buf);
+    return pending;
+}
+
+// 앞에서 len 바이트 송신 (블로킹 소켓이므로 SSL_write 는 전부 쓰거나 실패)
+bool RecordWriter::send(size_t len) {
+    if (SSL_write(ssl, buf.data(), static_cast<int>(len)) <= 0) {
+        logSslErrors();
+        error = true;
+        buf.clear();
+        return false;
+    }
+    countTlsRecords(len);
+    buf.erase(0, len);
+    return true;
+}
@@ -0,0 +1,83 @@
+// src/server/RequestArena.cpp
+
+#include <algorithm>
+#include <cstdint>
+
+#include "server/RequestArena.hpp"
+#include "server/ServerMetrics.hpp"
+
+RequestArena::RequestArena()
+    : initial(new std::byte[kInitialSize]),
+      mono(initial.get(), kInitialSize, &overflow) {}
+
+// 작업 스레드가 처음 명령을 실행할 때 만든다
+RequestArena& RequestArena::local() {
+    thread_local RequestArena arena;
+    return arena;
+}
+
+std::pmr::memory_resource* RequestArena::resource() {
+    RequestArena& arena = local();
+    return arena.active ? static_cast<std::pmr::memory_resource*>(&arena)
+                        : std::pmr::new_delete_resource();
+}
+
+bool RequestArena::owns(const void* p) {
+    RequestArena& arena = local();
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    auto inside = [addr](const std::byte* start, size_t size) {
+        auto begin = reinterpret_cast<uintptr_t>(start);
+        return addr >= begin && addr - begin < size;
+    };
+    if (inside(arena.initial.get(), kInitialSize)) return true;
+    return std::any_of(arena.overflow.blocks.begin(), arena.overflow.blocks.end(),
+                       [&](const auto& block) { return inside(block.first, block.second); });
+}
+
+RequestArena::Scope::Scope() {
+    local().active = true;
+}
+
+RequestArena::Scope::~Scope() {
+    RequestArena& arena = local();
+    ServerMetrics& m = serverMetrics();
+    m.arenaRequests.fetch_add(1, std::memory_order_relaxed);
+    m.arenaBytesUsed.fetch_add(arena.used, std::memory_order_relaxed);
+    raiseMax(m.arenaBytesMax, arena.used);
+    if (arena.overflow.bytes > 0) {
+        m.arenaOverflows.fetch_add(1, std::memory_order_relaxed);
+        m.arenaOverflowBytes.fetch_add(arena.overflow.bytes, std::memory_order_relaxed);
+    }
+
+    // 힙에서 더 받은 블록은 돌려주고 다음 요청은 초기 버퍼 처음부터
+    arena.mono.release();
+    arena.used = 0;
+    arena.overflow.bytes = 0;
+    arena.active = false;
+}
+
+void* RequestArena::do_allocate(size_t bytes, size_t align) {
+    used += bytes;
+    return mono.allocate(bytes, align);
+}
+
+bool RequestArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void* RequestArena::Overflow::do_allocate(size_t bytes, size_t align) {
+    this->bytes += bytes;
+    void* p = std::pmr::new_delete_resource()->allocate(bytes, align);
+    blocks.emplace_back(static_cast<std::byte*>(p), bytes);
+    return p;
+}
+
+void RequestArena::Overflow::do_deallocate(void* p, size_t bytes, size_t align) {
+    std::erase_if(blocks, [p](const auto& block) { return block.first == p; });
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+}
+
+bool RequestArena::Overflow::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
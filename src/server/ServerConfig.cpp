@@ -0,0 +1,80 @@
+// src/server/ServerConfig.cpp
+
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+#include "server/ServerConfig.hpp"
+#include "util/Logger.hpp"
+
+ServerConfig ServerConfig::fromArgs(int argc, char* argv[]) {
+    ServerConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        // "--name=N" 형식의 정수 옵션
+        auto intArg = [&arg](const char* prefix, int& field) {
+            if (arg.rfind(prefix, 0) != 0) return false;
+            field = std::atoi(arg.c_str() + strlen(prefix));
+            return true;
+        };
+
+        if (arg == "--io=thread") {
+            cfg.ioMode = IoMode::Thread;
+        } else if (arg == "--io=reactor") {
+            cfg.ioMode = IoMode::Reactor;
+        } else if (arg == "--io=coro") {
+            cfg.ioMode = IoMode::Coro;
+        } else if (arg == "--reuseport") {
+            cfg.reusePort = true;
+        } else if (arg == "--ktls") {
+            cfg.ktls = true;
+        } else if (arg == "--io-uring") {
+            cfg.ioUring = true;
+        } else if (arg.rfind("--upgrade-socket=", 0) == 0) {
+            cfg.upgradeSocket = arg.substr(strlen("--upgrade-socket="));
+        } else if (arg == "--log-level=debug") {
+            cfg.log.level = LogLevel::Debug;
+        } else if (arg == "--log-level=info") {
+            cfg.log.level = LogLevel::Info;
+        } else if (arg == "--log-level=warn") {
+            cfg.log.level = LogLevel::Warn;
+        } else if (arg == "--log-level=error") {
+            cfg.log.level = LogLevel::Error;
+        } else if (arg == "--log-format=text") {
+            cfg.log.format = LogFormat::Text;
+        } else if (arg == "--log-format=json") {
+            cfg.log.format = LogFormat::Json;
+        } else if (arg == "--log-format=binary") {
+            cfg.log.format = LogFormat::Binary;
+        } else if (arg.rfind("--local-socket=", 0) == 0) {
+            cfg.localSocket = arg.substr(strlen("--local-socket="));
+        } else if (arg.rfind("--local-socket-mode=", 0) == 0) {
+            cfg.localSocketMode = static_cast<int>(std::strtol(arg.c_str() + strlen("--local-socket-mode="),
+                                                               nullptr, 8));
+        } else if (arg.rfind("--log-file=", 0) == 0) {
+            cfg.log.file = arg.substr(strlen("--log-file="));
+        } else if (intArg("--loops=", cfg.loopThreads) ||
+                   intArg("--backlog=", cfg.backlog) ||
+                   intArg("--accept-batch=", cfg.acceptBatch) ||
+                   intArg("--handshake-timeout-ms=", cfg.handshakeTimeoutMs) ||
+                   intArg("--idle-timeout-ms=", cfg.idleTimeoutMs) ||
+                   intArg("--header-timeout-ms=", cfg.headerTimeoutMs) ||
+                   intArg("--upload-timeout-ms=", cfg.uploadTimeoutMs) ||
+                   intArg("--session-cache-size=", cfg.sessionCacheSize) ||
+                   intArg("--session-timeout-sec=", cfg.sessionTimeoutSec) ||
+                   intArg("--ticket-rotate-sec=", cfg.ticketRotateSec) ||
+                   intArg("--workers=", cfg.workerThreads) ||
+                   intArg("--queue=", cfg.queueCapacity) ||
+                   intArg("--max-connections=", cfg.maxConnections) ||
+                   intArg("--pipeline-depth=", cfg.pipelineDepth) ||
+                   intArg("--drain-timeout-sec=", cfg.drainTimeoutSec) ||
+                   intArg("--local-allow-uid=", cfg.localAllowUid) ||
+                   intArg("--log-rate-limit=", cfg.log.rateLimit)) {
+            continue;
+        } else {
+            LOG_WARN("[ServerConfig] Unknown option: ", arg);
+        }
+    }
+    return cfg;
+}
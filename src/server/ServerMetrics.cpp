@@ -0,0 +1,88 @@
+// src/server/ServerMetrics.cpp
+
+#include <json.hpp>
+
+#include "server/ServerMetrics.hpp"
+#include "util/Logger.hpp"
+
+ServerMetrics& serverMetrics() {
+    static ServerMetrics metrics;
+    return metrics;
+}
+
+std::string ServerMetrics::toJson() const {
+    uint64_t completed = jobsCompleted.load();
+    uint64_t responses = responsesSent.load();
+    uint64_t records   = tlsRecordsSent.load();
+    uint64_t arenaReqs = arenaRequests.load();
+    Logger&  logger    = Logger::instance();
+    nlohmann::json data = {
+        {"handshakes", {
+            {"in_flight", handshakesInFlight.load()},
+            {"completed", handshakesCompleted.load()},
+            {"failed", handshakesFailed.load()},
+            {"timed_out", handshakesTimedOut.load()}
+        }},
+        {"timeouts", {
+            {"idle", idleTimeouts.load()},
+            {"header", headerTimeouts.load()},
+            {"upload", uploadTimeouts.load()}
+        }},
+        {"tls_sessions", {
+            {"hits", sessionHits.load()},
+            {"misses", sessionMisses.load()},
+            {"tickets_issued", ticketsIssued.load()},
+            {"tickets_unknown_key", ticketsUnknownKey.load()}
+        }},
+        {"images", {
+            {"sent_ktls", imagesSentKtls.load()},
+            {"sent_buffered", imagesSentBuffered.load()},
+            {"sent_uring", imagesSentUring.load()},
+            {"uploads_uring", uploadsUring.load()},
+            {"bytes_sent", imageBytesSent.load()}
+        }},
+        {"output", {
+            {"responses", responses},
+            {"tls_records", records},
+            {"records_per_response", responses ? static_cast<double>(records) / responses : 0.0}
+        }},
+        {"arena", {
+            {"requests", arenaReqs},
+            {"bytes_avg", arenaReqs ? arenaBytesUsed.load() / arenaReqs : 0},
+            {"bytes_max", arenaBytesMax.load()},
+            {"overflows", arenaOverflows.load()},
+            {"overflow_bytes", arenaOverflowBytes.load()}
+        }},
+        {"log", {
+            {"written", logger.written.load()},
+            {"dropped", logger.dropped.load()},
+            {"suppressed", logger.suppressed.load()}
+        }},
+        {"connections", {
+            {"active", connectionsActive.load()},
+            {"rejected", connectionsRejected.load()}
+        }},
+        {"events", {
+            {"subscribers", eventSubscribers.load()},
+            {"published", eventsPublished.load()},
+            {"queued", eventsQueued.load()},
+            {"sent", eventsSent.load()},
+            {"dropped_subscribers", eventSubscribersDropped.load()}
+        }},
+        {"local", {
+            {"connections", localConnections.load()},
+            {"rejected_peer", localRejected.load()}
+        }},
+        {"worker_pool", {
+            {"submitted", jobsSubmitted.load()},
+            {"rejected", jobsRejected.load()},
+            {"completed", completed},
+            {"pipelined", jobsPipelined.load()},
+            {"queue_depth", queueDepth.load()},
+            {"queue_depth_max", queueDepthMax.load()},
+            {"wait_avg_us", completed ? queueWaitTotalUs.load() / completed : 0},
+            {"wait_max_us", queueWaitMaxUs.load()}
+        }}
+    };
+    return data.dump();
+}
@@ -4,17 +4,38 @@
 #include <openssl/err.h>
 
 #include <sys/socket.h>
+#include <sys/eventfd.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <pthread.h>
 #include <signal.h>
-#include <sstream>
-#include <iostream>
 #include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <future>
+#include <thread>
 
 #include "server/TcpServer.hpp"
+#include "server/EventBroadcaster.hpp"
+#include "server/EventLoop.hpp"
+#include "server/CoroLoop.hpp"
+#include "server/ConnectionWatchdog.hpp"
+#include "server/ListenerHandoff.hpp"
+#include "server/LocalListener.hpp"
+#include "server/ReadBuffer.hpp"
+#include "server/RecordWriter.hpp"
+#include "server/Frame.hpp"
+#include "server/WorkerPool.hpp"
+#include "server/TlsSessionCache.hpp"
 #include "server/CommandHandler.hpp"
+#include "server/CommandArgs.hpp"
+#include "server/CommandTable.hpp"
 #include "server/ImageHandler.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/EndianUtils.hpp"
+#include "util/Logger.hpp"
 
 // main.cpp 에서 초기화된 commandHandler
 extern CommandHandler* commandHandler;
@@ -22,158 +43,695 @@ extern CommandHandler* commandHandler;
 // pthread 로 넘길 인자 구조체
 struct ClientHandlerArgs {
     int        client_fd;
-    SSL*       ssl;
     TcpServer* server;
 };
 
-// 클라이언트별 스레드 함수
+// 클라이언트별 스레드 함수: 핸드쉐이크도 accept 스레드가 아닌 여기서 수행
 static void* client_thread_func(void* arg) {
     auto* args = static_cast<ClientHandlerArgs*>(arg);
     int client_fd    = args->client_fd;
-    SSL* ssl         = args->ssl;
     TcpServer* serv  = args->server;
     delete args;
 
+    SSL* ssl = SSL_new(serv->getSslContext());
+    if (!ssl) {
+        logSslErrors();
+        close(client_fd);
+        serv->releaseConnection();
+        return nullptr;
+    }
+    SSL_set_fd(ssl, client_fd);
+    if (!serv->acceptTls(client_fd, ssl)) {
+        SSL_free(ssl);
+        close(client_fd);
+        serv->releaseConnection();
+        return nullptr;
+    }
+    LOG_INFO("[TcpServer] SSL handshake OK (fd=", client_fd, ")");
+
     serv->handleClientSSL(client_fd, ssl);
 
     // 연결 종료
     SSL_shutdown(ssl);
     SSL_free(ssl);
     close(client_fd);
+    serv->releaseConnection();
     return nullptr;
 }
 
 TcpServer::TcpServer(SSL_CTX* ctx)
-  : server_fd(-1), sslCtx(ctx), imageHandler(nullptr) {
+  : server_fd(-1), acceptWakeFd(eventfd(0, EFD_CLOEXEC)), sslCtx(ctx), imageHandler(nullptr),
+    nextLoop(0) {
     // SIGPIPE 방지
     signal(SIGPIPE, SIG_IGN);
 }
 
 TcpServer::~TcpServer() {
-    if (server_fd != -1) close(server_fd);
+    for (int fd : listenFds) close(fd);
+    close(acceptWakeFd);
 }
 
 void TcpServer::setImageHandler(ImageHandler* handler) {
     imageHandler = handler;
 }
 
+void TcpServer::setConfig(const ServerConfig& cfg) {
+    config = cfg;
+}
+
 void TcpServer::setupSocket(int port) {
-    server_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_fd < 0) {
-        perror("socket");
+    bool sharded = config.ioMode != IoMode::Thread && config.reusePort;
+    size_t count = sharded ? loopCount() : 1;
+
+    // 무중단 재시작: 실행 중인 서버의 리스너를 그대로 넘겨받는다 (accept 큐 유지)
+    if (!config.upgradeSocket.empty()) {
+        listenFds = ListenerHandoff::receive(config.upgradeSocket);
+        if (!listenFds.empty()) {
+            LOG_INFO("[TcpServer] Took over ", listenFds.size(),
+                     " listener(s) from running server");
+        }
+    }
+    if (listenFds.size() > count) {
+        // 루프 수가 줄었다: 남는 리스너의 accept 큐에 있던 연결은 끊긴다
+        for (size_t i = count; i < listenFds.size(); ++i) close(listenFds[i]);
+        listenFds.resize(count);
+    }
+    if (!listenFds.empty() && listenFds.size() < count) {
+        // SO_REUSEPORT 없이 열린 리스너를 받았으면 같은 포트에 더 열 수 없다: 받은 것만 사용
+        int on = 0;
+        socklen_t len = sizeof(on);
+        getsockopt(listenFds[0], SOL_SOCKET, SO_REUSEPORT, &on, &len);
+        if (!on) count = listenFds.size();
+    }
+    while (listenFds.size() < count) {
+        listenFds.push_back(openListener(port, sharded));
+    }
+    server_fd = listenFds[0];
+    LOG_INFO("[TcpServer] Listening on port ", port,
+             " (", listenFds.size(), " listener(s), backlog ", config.backlog, ")");
+}
+
+int TcpServer::openListener(int port, bool reusePort) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        logErrno("socket");
         exit(EXIT_FAILURE);
     }
 
     int opt = 1;
-    setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    if (reusePort && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        logErrno("setsockopt(SO_REUSEPORT)");
+        exit(EXIT_FAILURE);
+    }
 
     sockaddr_in addr{};
     addr.sin_family      = AF_INET;
     addr.sin_port        = htons(port);
     addr.sin_addr.s_addr = INADDR_ANY;
 
-    if (bind(server_fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
-        perror("bind");
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        logErrno("bind");
         exit(EXIT_FAILURE);
     }
-    if (listen(server_fd, 10) < 0) {
-        perror("listen");
+    if (listen(fd, config.backlog) < 0) {
+        logErrno("listen");
         exit(EXIT_FAILURE);
     }
-    std::cout << "[TcpServer] Listening on port " << port << "\n";
+    return fd;
+}
+
+int TcpServer::loopCount() const {
+    int n = config.loopThreads;
+    if (n <= 0) n = static_cast<int>(std::thread::hardware_concurrency());
+    return n > 0 ? n : 1;
 }
 
 void TcpServer::start() {
+    int workers = config.workerThreads;
+    if (workers <= 0) workers = static_cast<int>(std::thread::hardware_concurrency());
+    pool = std::make_unique<WorkerPool>(workers > 0 ? workers : 1,
+                                        static_cast<size_t>(config.queueCapacity));
+
+    if (config.ioMode == IoMode::Thread || !config.localSocket.empty()) {
+        watchdog = std::make_unique<ConnectionWatchdog>();
+    }
+    startHandoff();
+    startLocal();
+
+    if (config.ioMode == IoMode::Reactor) {
+        startReactor();
+    } else if (config.ioMode == IoMode::Coro) {
+        startCoro();
+    } else {
+        startThreaded();
+    }
+}
+
+void TcpServer::startReactor() {
+    int n = loopCount();
+    for (int i = 0; i < n; ++i) {
+        loops.push_back(std::make_unique<EventLoop>(this, i));
+    }
+
+    // 루프가 둘 이상이고 루프마다 리스너가 있을 때만 샤딩 (인계받은 리스너가 모자라면 0번 루프가 accept)
+    bool sharded = config.reusePort && n > 1 && listenFds.size() == loops.size();
+    if (sharded) {
+        // SO_REUSEPORT: 커널이 루프별 리스너로 연결을 분산, 각 루프가 직접 accept
+        for (int i = 0; i < n; ++i) loops[i]->addListener(listenFds[i], true);
+    } else {
+        // 0번 루프가 accept 를 맡고, 연결은 모든 루프에 분배한다
+        loops[0]->addListener(server_fd, false);
+    }
+    LOG_INFO("[TcpServer] Reactor mode with ", n, " event loop(s)",
+             (sharded ? ", SO_REUSEPORT accept sharding" : ""));
+
+    for (int i = 1; i < n; ++i) {
+        EventLoop* loop = loops[i].get();
+        std::thread([loop] { loop->run(); }).detach();
+    }
+    loops[0]->run();
+}
+
+void TcpServer::startCoro() {
+    int n = loopCount();
+    for (int i = 0; i < n; ++i) {
+        coroLoops.push_back(std::make_unique<CoroLoop>(this, i));
+    }
+
+    bool sharded = config.reusePort && n > 1 && listenFds.size() == coroLoops.size();
+    for (int i = 0; i < n; ++i) {
+        // 코루틴은 자기 루프를 떠나지 않으므로 각 루프가 직접 accept 한다
+        coroLoops[i]->addListener(sharded ? listenFds[i] : server_fd, !sharded && n > 1);
+    }
+    LOG_INFO("[TcpServer] Coroutine mode with ", n, " loop(s)",
+             (sharded ? ", SO_REUSEPORT accept sharding" : ""));
+
+    for (int i = 1; i < n; ++i) {
+        CoroLoop* loop = coroLoops[i].get();
+        std::thread([loop] { loop->run(); }).detach();
+    }
+    coroLoops[0]->run();
+}
+
+bool TcpServer::admitConnection() {
+    ServerMetrics& m = serverMetrics();
+    if (m.connectionsActive.fetch_add(1) >= config.maxConnections) {
+        m.connectionsActive--;
+        m.connectionsRejected++;
+        return false;
+    }
+    return true;
+}
+
+void TcpServer::releaseConnection() {
+    serverMetrics().connectionsActive--;
+}
+
+std::string TcpServer::executeCommand(const std::string& cmd) {
+    std::promise<std::string> done;
+    std::future<std::string> result = done.get_future();
+    if (!pool->trySubmit([&done, &cmd] { done.set_value(commandHandler->handle(cmd)); })) {
+        return kServerBusyResponse;
+    }
+    return result.get();
+}
+
+std::vector<std::string> TcpServer::executeCommands(const std::vector<std::string>& cmds) {
+    std::vector<std::promise<std::string>> done(cmds.size());
+    std::vector<std::future<std::string>>  results;
+    results.reserve(cmds.size());
+    for (size_t i = 0; i < cmds.size(); ++i) {
+        results.push_back(done[i].get_future());
+        std::promise<std::string>& p = done[i];
+        const std::string& cmd = cmds[i];
+        if (!pool->trySubmit([&p, &cmd] { p.set_value(commandHandler->handle(cmd)); })) {
+            p.set_value(kServerBusyResponse);
+        } else if (i > 0) {
+            serverMetrics().jobsPipelined++;
+        }
+    }
+
+    std::vector<std::string> responses;
+    responses.reserve(cmds.size());
+    for (auto& f : results) responses.push_back(f.get());
+    return responses;
+}
+
+void TcpServer::dispatchConnection(int client_fd) {
+    size_t idx = nextLoop.fetch_add(1, std::memory_order_relaxed) % loops.size();
+    loops[idx]->adoptConnection(client_fd);
+}
+
+void TcpServer::startThreaded() {
+    LOG_INFO("[TcpServer] Thread-per-connection mode");
+    if (config.reusePort) {
+        LOG_WARN("[TcpServer] --reuseport is only used in reactor mode");
+    }
     while (true) {
+        // 인계 후 깨울 수 있도록 리스너와 함께 acceptWakeFd 를 기다린다
+        pollfd pfds[2] = {{server_fd, POLLIN, 0}, {acceptWakeFd, POLLIN, 0}};
+        if (poll(pfds, 2, -1) < 0) {
+            if (errno != EINTR) logErrno("poll");
+            continue;
+        }
+        if (pfds[1].revents & POLLIN) break;
+
         sockaddr_in client_addr{};
         socklen_t len = sizeof(client_addr);
         int client_fd = accept(server_fd, (sockaddr*)&client_addr, &len);
         if (client_fd < 0) {
-            perror("accept");
+            // 이전 서버가 넘겨준 리스너는 논블로킹일 수 있다
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) logErrno("accept");
             continue;
         }
 
-        std::cout << "[TcpServer] TCP connection fd=" << client_fd << "\n";
+        LOG_INFO("[TcpServer] TCP connection fd=", client_fd);
 
-        // SSL 핸드쉐이크
-        SSL* ssl = SSL_new(sslCtx);
-        SSL_set_fd(ssl, client_fd);
-        if (SSL_accept(ssl) <= 0) {
-            ERR_print_errors_fp(stderr);
-            SSL_free(ssl);
+        // 연결 상한 초과: TLS 전이라 응답 없이 바로 종료
+        if (!admitConnection()) {
+            LOG_WARN("[TcpServer] Connection limit reached, rejecting fd=", client_fd);
             close(client_fd);
             continue;
         }
-        std::cout << "[TcpServer] SSL handshake OK (fd=" << client_fd << ")\n";
 
-        // 스레드로 분기
-        auto* args = new ClientHandlerArgs{client_fd, ssl, this};
+        // 스레드로 분기 (SSL 핸드쉐이크는 스레드에서)
+        auto* args = new ClientHandlerArgs{client_fd, this};
         pthread_t tid;
         if (pthread_create(&tid, nullptr, client_thread_func, args) != 0) {
-            perror("pthread_create");
-            SSL_shutdown(ssl);
-            SSL_free(ssl);
+            logErrno("pthread_create");
             close(client_fd);
+            releaseConnection();
             delete args;
             continue;
         }
         pthread_detach(tid);
     }
+
+    for (int fd : listenFds) close(fd);
+    // 연결 스레드들이 남은 요청을 마칠 때까지 대기 (drain 이 프로세스를 끝낸다)
+    while (true) pause();
+}
+
+void TcpServer::startLocal() {
+    if (config.localSocket.empty()) return;
+    local = std::make_unique<LocalListener>(this);
+    if (!local->open(config.localSocket, config.localSocketMode)) {
+        LOG_WARN("[TcpServer] Local socket unavailable: ", config.localSocket);
+        local.reset();
+        return;
+    }
+    local->start();
+}
+
+void TcpServer::startHandoff() {
+    if (config.upgradeSocket.empty()) return;
+    int handoffFd = ListenerHandoff::listen(config.upgradeSocket);
+    if (handoffFd < 0) {
+        LOG_WARN("[TcpServer] Upgrade socket unavailable: ", config.upgradeSocket);
+        return;
+    }
+    LOG_INFO("[TcpServer] Waiting for upgrade handoff on ", config.upgradeSocket);
+
+    std::thread([this, handoffFd] {
+        if (ListenerHandoff::serve(handoffFd, config.upgradeSocket, listenFds)) drain();
+    }).detach();
+}
+
+void TcpServer::drain() {
+    LOG_INFO("[TcpServer] Listeners handed off, draining ",
+             serverMetrics().connectionsActive.load(), " connection(s)");
+
+    // 1. accept 중단 + 다음 명령을 기다리던 연결 종료. 처리 중인 요청과 업로드는 마저 끝낸다
+    //    (로컬 소켓 경로는 새 서버가 이미 다시 만들었다)
+    if (local) local->drain();
+    if (watchdog) watchdog->drain();
+    if (config.ioMode == IoMode::Thread) {
+        uint64_t one = 1;
+        ssize_t r = write(acceptWakeFd, &one, sizeof(one));
+        (void)r;
+    } else {
+        std::vector<std::future<void>> stopped;
+        auto drainLoop = [&stopped](auto& loop) {
+            auto done = std::make_shared<std::promise<void>>();
+            stopped.push_back(done->get_future());
+            loop->post([&loop, done] {
+                loop->drain();
+                done->set_value();
+            });
+        };
+        for (auto& loop : loops) drainLoop(loop);
+        for (auto& loop : coroLoops) drainLoop(loop);
+        for (auto& f : stopped) f.wait();
+        // 모든 루프가 리스너를 뺀 뒤에 닫는다 (새 서버의 사본은 그대로 열려 있다)
+        for (int fd : listenFds) close(fd);
+    }
+
+    // 2. 남은 연결이 모두 끝나거나 제한 시간이 지나면 종료
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(config.drainTimeoutSec);
+    while (serverMetrics().connectionsActive.load() > 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    LOG_INFO("[TcpServer] Drain finished, ", serverMetrics().connectionsActive.load(),
+             " connection(s) left, exiting");
+    // 다른 스레드가 아직 돌고 있으므로 정적 소멸자를 거치지 않고 끝낸다 (로그만 비운다)
+    Logger::instance().stop();
+    _exit(0);
+}
+
+bool TcpServer::acceptTls(int client_fd, SSL* ssl) {
+    ServerMetrics& m = serverMetrics();
+    m.handshakesInFlight++;
+
+    // 제한 시간을 지키기 위해 핸드쉐이크 동안만 논블로킹 + poll
+    int flags = fcntl(client_fd, F_GETFL, 0);
+    fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(config.handshakeTimeoutMs);
+    bool ok = false;
+    bool timedOut = false;
+    while (true) {
+        int ret = SSL_accept(ssl);
+        if (ret == 1) {
+            ok = true;
+            break;
+        }
+
+        int err = SSL_get_error(ssl, ret);
+        pollfd pfd{client_fd, 0, 0};
+        if (err == SSL_ERROR_WANT_READ) {
+            pfd.events = POLLIN;
+        } else if (err == SSL_ERROR_WANT_WRITE) {
+            pfd.events = POLLOUT;
+        } else {
+            logSslErrors();
+            break;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            timedOut = true;
+            break;
+        }
+        int pr = poll(&pfd, 1, static_cast<int>(remaining));
+        if (pr == 0) {
+            timedOut = true;
+            break;
+        }
+        if (pr < 0 && errno != EINTR) {
+            logErrno("poll");
+            break;
+        }
+    }
+
+    fcntl(client_fd, F_SETFL, flags);  // 이후 명령 처리는 블로킹
+    m.handshakesInFlight--;
+    if (ok) {
+        m.handshakesCompleted++;
+        TlsSessionCache::recordHandshake(ssl);
+    } else if (timedOut) {
+        m.handshakesTimedOut++;
+        LOG_WARN("[TcpServer] SSL handshake timed out (fd=", client_fd, ")");
+    } else {
+        m.handshakesFailed++;
+    }
+    return ok;
 }
 
 
 bool TcpServer::handleClientSSL(int client_fd, SSL* ssl) {
+    bool result = serveClient(client_fd, ssl);
+    // 호출자가 fd 를 닫기 전에 감시 해제
+    if (watchdog) watchdog->disarm(client_fd);
+    return result;
+}
+
+bool TcpServer::serveClient(int client_fd, SSL* ssl) {
+    // 블로킹 읽기가 멈춰 있으면 감시 스레드가 shutdown(fd) 으로 깨운다
+    TimeoutKind armed = TimeoutKind::None;
+    auto arm = [&](TimeoutKind kind, int timeoutMs, bool betweenRequests = false) {
+        armed = kind;
+        if (watchdog) watchdog->arm(client_fd, kind, timeoutMs, betweenRequests);
+    };
+
+    ReadBuffer rbuf;
+    RecordWriter out(ssl);
+    bool served = false;
     while (true) {
-        std::string cmd;
-        char ch;
-        int n;
-        while (true) {
-            n = SSL_read(ssl, &ch, 1);
+        // 버퍼에 완성된 줄이 생길 때까지 레코드 단위로 읽기
+        size_t lineLen;
+        while ((lineLen = rbuf.findLine()) == 0) {
+            // 처리할 줄이 더 없으면 모아 둔 응답을 보내고 기다린다
+            if (!out.flush()) return false;
+            if (rbuf.size() > ReadBuffer::kMaxLineLength) {
+                LOG_WARN("[TcpServer] Line too long, closing fd=", client_fd);
+                return false;
+            }
+            // 줄을 받기 시작한 뒤로는 바이트가 와도 연장하지 않는다
+            if (rbuf.empty()) {
+                // 드레인 중이어도 첫 요청은 받아 준다
+                arm(TimeoutKind::Idle, config.idleTimeoutMs, served);
+            } else if (armed != TimeoutKind::Header) {
+                arm(TimeoutKind::Header, config.headerTimeoutMs);
+            }
+            char* dst = rbuf.prepareWrite();
+            int n = SSL_read(ssl, dst, static_cast<int>(rbuf.writable()));
             if (n <= 0) {
-                if (n < 0) ERR_print_errors_fp(stderr);
+                if (n < 0) logSslErrors();
                 return false;
             }
-            cmd.push_back(ch);
-            if (ch == '\n') break;
+            rbuf.commit(n);
         }
+        std::string cmd(rbuf.data(), lineLen);
+        rbuf.consume(lineLen);
+        // 명령 실행과 응답 송신은 유휴 제한 시간 안에
+        arm(TimeoutKind::Idle, config.idleTimeoutMs);
 
         if (cmd == "\n") continue;
-        std::cout << "[TcpServer] Received: " << cmd;
+        LOG_INFO("[TcpServer] Received: ", cmd);
+        served = true;
+        CommandId command = commandId(cmd);
 
         // UPLOAD 처리
-        if (cmd.rfind("UPLOAD", 0) == 0 && imageHandler) {
-            std::istringstream iss(cmd);
-            std::string tag, filename;
-            size_t filesize;
-            iss >> tag >> filename >> filesize;
+        if (command == CommandId::Upload && imageHandler) {
+            std::string_view filename;
+            size_t filesize = 0;
+            if (!parseArgs(commandArgs(cmd), 2, filename, filesize)) filesize = 0;
 
             if (filename.empty() || filesize == 0) {
                 const char* err = R"({"status":"error","code":400,"message":"Invalid filename or filesize"}\n)";
-                SSL_write(ssl, err, strlen(err));
+                if (!out.append(err, strlen(err))) return false;
             } else {
-                std::string result = imageHandler->handleImageUpload(ssl, filename, filesize);
+                if (!out.flush()) return false;
+                arm(TimeoutKind::Upload, config.uploadTimeoutMs);
+                std::string result = imageHandler->handleImageUpload(
+                    ssl, std::string(filename), filesize, &rbuf,
+                    [&](size_t) { arm(TimeoutKind::Upload, config.uploadTimeoutMs); });
+                arm(TimeoutKind::Idle, config.idleTimeoutMs);
                 if (result.back() != '\n') result.push_back('\n');
-                SSL_write(ssl, result.c_str(), result.size());
+                if (!out.append(result)) return false;
             }
-        } else if (cmd.rfind("GET_IMAGE", 0) == 0 && imageHandler != nullptr) {
-    std::istringstream iss(cmd);
-    std::string tag, imagePath;
-    iss >> tag >> imagePath;
+        } else if (command == CommandId::GetImage && imageHandler != nullptr) {
+    std::string_view imagePath;
+    if (!parseArgs(commandArgs(cmd), 1, imagePath)) imagePath = {};
 
     if (imagePath.empty()) {
         std::string error = R"({"status": "error", "code": 400, "message": "Missing image path"})";
-        SSL_write(ssl, error.c_str(), error.size());  // ✅ TLS로 전송
+        out.append(error);
+        out.flush();  // ✅ TLS로 전송
         return false;
     }
 
-    imageHandler->handleGetImage(ssl, imagePath);  // ✅ SSL 기반 이미지 전송
+    // 앞선 응답이 남아 있으면 길이 헤더, 본문과 함께 보낸다
+    imageHandler->handleGetImage(ssl, std::string(imagePath), out.take());  // ✅ SSL 기반 이미지 전송
     return true;
 }
- else {
-            std::string resp = commandHandler->handle(cmd);
+ else if (command == CommandId::SubscribeEvents) {
+            int eventType;
+            if (!parseSubscribe(cmd, eventType)) {
+                const char* err = R"({"status": "error", "code": 400, "message": "Invalid event type"})" "\n";
+                if (!out.append(err, strlen(err))) return false;
+                continue;
+            }
+            if (!out.flush()) return false;
+            // 이벤트를 기다리는 동안에는 제한 시간 없이 유지하고 (드레인 때는 닫는다),
+            // 보내는 동안에만 유휴 제한 시간으로 못 읽는 구독자를 끊는다
+            arm(TimeoutKind::Idle, 0, true);
+            streamEvents(client_fd, eventType,
+                         [&](std::string_view data) {
+                             arm(TimeoutKind::Idle, config.idleTimeoutMs);
+                             bool ok = SSL_write(ssl, data.data(), static_cast<int>(data.size())) > 0;
+                             if (ok) countTlsRecords(data.size());
+                             arm(TimeoutKind::Idle, 0, true);
+                             return ok;
+                         },
+                         [&] {
+                             char discard[512];
+                             return SSL_read(ssl, discard, sizeof(discard)) > 0;
+                         });
+            return false;
+        } else if (command == CommandId::Proto) {
+            // 프레이밍 협상: 응답은 텍스트, 이후 바이트는 바이너리 프레임
+            std::string_view mode;
+            if (!parseArgs(commandArgs(cmd), 1, mode)) mode = {};
+            std::string resp;
+            if (mode == "BINARY") {
+                resp = R"({"status": "success", "code": 200, "message": "Binary framing enabled", "version": 1})";
+            } else if (mode == "TEXT") {
+                resp = R"({"status": "success", "code": 200, "message": "Text protocol"})";
+            } else {
+                resp = R"({"status": "error", "code": 400, "message": "Unknown protocol"})";
+            }
+            resp.push_back('\n');
+            if (!out.append(resp) || !out.flush()) return false;
+            if (mode == "BINARY") return serveBinary(client_fd, ssl, rbuf);
+        } else if (CommandHandler::isReadOnly(cmd)) {
+            // 이미 도착해 있는 뒤따르는 조회 명령을 함께 실행하고 요청 순서대로 응답
+            std::vector<std::string> batch{cmd};
+            while (batch.size() < static_cast<size_t>(config.pipelineDepth) &&
+                   (lineLen = rbuf.findLine()) > 0) {
+                std::string next(rbuf.data(), lineLen);
+                if (!CommandHandler::isReadOnly(next)) break;
+                rbuf.consume(lineLen);
+                LOG_INFO("[TcpServer] Received: ", next);
+                batch.push_back(std::move(next));
+            }
+
+            for (std::string& resp : executeCommands(batch)) {
+                if (resp.back() != '\n') resp.push_back('\n');
+                if (!out.append(resp)) return false;
+            }
+        } else {
+            std::string resp = executeCommand(cmd);
             if (resp.back() != '\n') resp.push_back('\n');
-            SSL_write(ssl, resp.c_str(), resp.size());
+            if (!out.append(resp)) return false;
         }
     }
     return false;
 }
+
+bool TcpServer::serveBinary(int client_fd, SSL* ssl, ReadBuffer& rbuf) {
+    TimeoutKind armed = TimeoutKind::None;
+    auto arm = [&](TimeoutKind kind, int timeoutMs, bool betweenRequests = false) {
+        armed = kind;
+        if (watchdog) watchdog->arm(client_fd, kind, timeoutMs, betweenRequests);
+    };
+
+    RecordWriter out(ssl);
+
+    // rbuf 에 n 바이트 이상 모일 때까지 읽기. 프레임 도중이면 헤더 제한 시간 (연장 없음).
+    // 읽기 전에 모아 둔 응답 프레임을 보낸다
+    auto fill = [&](size_t n, bool uploading) {
+        while (rbuf.size() < n) {
+            if (!out.flush()) return false;
+            if (uploading) {
+                arm(TimeoutKind::Upload, config.uploadTimeoutMs);
+            } else if (rbuf.empty()) {
+                arm(TimeoutKind::Idle, config.idleTimeoutMs, true);
+            } else if (armed != TimeoutKind::Header) {
+                arm(TimeoutKind::Header, config.headerTimeoutMs);
+            }
+            char* dst = rbuf.prepareWrite(n - rbuf.size());
+            int r = SSL_read(ssl, dst, static_cast<int>(rbuf.writable()));
+            if (r <= 0) {
+                if (r < 0) logSslErrors();
+                return false;
+            }
+            rbuf.commit(r);
+        }
+        return true;
+    };
+
+    while (true) {
+        if (!fill(FrameHeader::kSize, false)) return false;
+        FrameHeader h = FrameHeader::decode(rbuf.data());
+        std::string frame;
+
+        if (h.opcode == kFrameUpload) {
+            if (!fill(FrameHeader::kSize + 2, false)) return false;
+            size_t nameLen = readBE16(rbuf.data() + FrameHeader::kSize);
+            if (h.length < 2 + nameLen) {
+                LOG_WARN("[TcpServer] Malformed upload frame, closing fd=", client_fd);
+                return false;
+            }
+            if (!fill(FrameHeader::kSize + 2 + nameLen, false)) return false;
+            std::string filename(rbuf.data() + FrameHeader::kSize + 2, nameLen);
+            size_t filesize = h.length - 2 - nameLen;
+            rbuf.consume(FrameHeader::kSize + 2 + nameLen);
+            LOG_INFO("[TcpServer] Received frame: UPLOAD ", filename, " ", filesize);
+
+            // 거절해도 프레임 경계를 맞추기 위해 본문은 끝까지 읽는다
+            UploadSession up;
+            std::string resp = imageHandler ? imageHandler->beginUpload(filename, filesize, up)
+                                            : R"({"status":"error","code":500,"message":"Upload unavailable"})";
+            bool accepted = resp.empty();
+            size_t remaining = filesize;
+            while (remaining > 0) {
+                if (!fill(1, true)) {
+                    if (accepted) imageHandler->abortUpload(up);
+                    return false;
+                }
+                size_t take = std::min(rbuf.size(), remaining);
+                if (accepted) up.write(rbuf.data(), take);
+                rbuf.consume(take);
+                remaining -= take;
+            }
+            if (accepted) resp = imageHandler->finishUpload(up);
+            appendJsonResponse(frame, kFrameUpload, h.requestId, resp);
+            if (!out.append(frame)) return false;
+            continue;
+        }
+
+        if (h.length > ReadBuffer::kMaxLineLength) {
+            LOG_WARN("[TcpServer] Frame too large, closing fd=", client_fd);
+            return false;
+        }
+        if (!fill(FrameHeader::kSize + h.length, false)) return false;
+        std::string payload(rbuf.data() + FrameHeader::kSize, h.length);
+        rbuf.consume(FrameHeader::kSize + h.length);
+        // 실행과 응답 송신은 유휴 제한 시간 안에
+        arm(TimeoutKind::Idle, config.idleTimeoutMs);
+
+        if (h.opcode == kFrameCommand) {
+            LOG_INFO("[TcpServer] Received frame: ", payload);
+            appendJsonResponse(frame, kFrameCommand, h.requestId, executeCommand(payload));
+        } else if (h.opcode == kFrameGetImage && imageHandler) {
+            LOG_INFO("[TcpServer] Received frame: GET_IMAGE ", payload);
+            size_t fileSize = 0;
+            int fd = ImageHandler::openImage(payload, fileSize);
+            if (fd >= 0 && fileSize <= UINT32_MAX) {
+                FrameHeader rh;
+                rh.opcode    = kFrameGetImage | kFrameResponse;
+                rh.requestId = h.requestId;
+                rh.length    = static_cast<uint32_t>(fileSize);
+                char hdr[FrameHeader::kSize];
+                rh.encode(hdr);
+                // 앞선 응답 프레임과 응답 헤더를 본문 첫 조각과 함께 보낸다
+                std::string prefix = out.take();
+                prefix.append(hdr, sizeof(hdr));
+                serverMetrics().responsesSent++;
+                bool ok = imageHandler->sendImage(ssl, fd, fileSize, prefix);
+                close(fd);
+                if (!ok) return false;
+                continue;
+            }
+            if (fd >= 0) {
+                close(fd);
+                appendJsonResponse(frame, kFrameGetImage, h.requestId,
+                                   R"({"status": "error", "code": 413, "message": "Image too large for frame"})");
+            } else {
+                appendJsonResponse(frame, kFrameGetImage, h.requestId,
+                                   payload.empty()
+                                       ? R"({"status": "error", "code": 400, "message": "Missing image path"})"
+                                       : R"({"status": "error", "code": 404, "message": "Image not found"})");
+            }
+        } else {
+            appendJsonResponse(frame, h.opcode, h.requestId,
+                               R"({"status": "error", "code": 400, "message": "Unknown opcode"})");
+        }
+        if (!out.append(frame)) return false;
+    }
+}
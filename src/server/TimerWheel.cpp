@@ -0,0 +1,61 @@
+// src/server/TimerWheel.cpp
+
+#include <algorithm>
+
+#include "server/TimerWheel.hpp"
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slotCount)
+  : tick(tick), origin(Clock::now()), current(0), slots(slotCount ? slotCount : 1) {}
+
+uint64_t TimerWheel::ticksSinceOrigin(Clock::time_point t, bool roundUp) const {
+    if (t <= origin) return 0;
+    auto elapsed = t - origin;
+    uint64_t n = elapsed / tick;
+    if (roundUp && elapsed % tick != Clock::duration::zero()) ++n;
+    return n;
+}
+
+void TimerWheel::schedule(uint64_t id, Clock::time_point deadline) {
+    cancel(id);
+    // 마감 전에 만료되지 않도록 올림, 이미 지난 tick 이면 다음 검사 때 만료
+    uint64_t expireTick = std::max(ticksSinceOrigin(deadline, true), current);
+    auto& slot = slots[expireTick % slots.size()];
+    slot.push_back(id);
+    entries[id] = Entry{expireTick, std::prev(slot.end())};
+}
+
+void TimerWheel::cancel(uint64_t id) {
+    auto it = entries.find(id);
+    if (it == entries.end()) return;
+    slots[it->second.expireTick % slots.size()].erase(it->second.pos);
+    entries.erase(it);
+}
+
+void TimerWheel::advance(Clock::time_point now, std::vector<uint64_t>& expired) {
+    uint64_t nowTick = ticksSinceOrigin(now, false);
+    if (nowTick < current) return;
+
+    // 오래 깨어나지 않았어도 휠을 한 바퀴만 돌면 모든 슬롯을 본다
+    uint64_t last = std::min(nowTick, current + slots.size() - 1);
+    for (uint64_t t = current; t <= last && !entries.empty(); ++t) {
+        auto& slot = slots[t % slots.size()];
+        for (auto it = slot.begin(); it != slot.end();) {
+            auto entry = entries.find(*it);
+            if (entry->second.expireTick <= nowTick) {
+                expired.push_back(*it);
+                entries.erase(entry);
+                it = slot.erase(it);
+            } else {
+                ++it;  // 이후 바퀴에서 만료
+            }
+        }
+    }
+    current = nowTick + 1;
+}
+
+int TimerWheel::nextTimeoutMs(Clock::time_point now) const {
+    if (entries.empty()) return -1;
+    auto next = origin + tick * current;
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count();
+    return wait > 0 ? static_cast<int>(wait) + 1 : 0;
+}
@@ -0,0 +1,161 @@
+// src/server/TlsSessionCache.cpp
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#include "server/TlsSessionCache.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/Logger.hpp"
+
+namespace {
+
+// 세션 ID 컨텍스트: 클라이언트 인증서 검증(SSL_VERIFY_PEER)을 쓰면서
+// 세션을 캐시하려면 반드시 설정해야 한다
+const unsigned char kSessionIdContext[] = "raspi-cctv-server";
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+
+struct TicketKey {
+    unsigned char name[16];
+    unsigned char aesKey[32];
+    unsigned char hmacKey[32];
+    std::chrono::steady_clock::time_point createdAt;
+    bool valid = false;
+};
+
+// 현재 키로 새 티켓을 암호화하고, 직전 키로 만든 티켓은 한 주기 더 받아 준다
+struct TicketKeyRing {
+    std::mutex mtx;
+    TicketKey  current;
+    TicketKey  previous;
+    std::chrono::seconds rotateEvery{3600};
+};
+
+TicketKeyRing& keyRing() {
+    static TicketKeyRing ring;
+    return ring;
+}
+
+bool generateKey(TicketKey& key) {
+    if (RAND_bytes(key.name, sizeof(key.name)) != 1 ||
+        RAND_bytes(key.aesKey, sizeof(key.aesKey)) != 1 ||
+        RAND_bytes(key.hmacKey, sizeof(key.hmacKey)) != 1) {
+        return false;
+    }
+    key.createdAt = std::chrono::steady_clock::now();
+    key.valid = true;
+    return true;
+}
+
+// ring.mtx 를 잡은 상태에서 호출
+void rotateIfDue(TicketKeyRing& ring) {
+    auto now = std::chrono::steady_clock::now();
+    if (ring.current.valid && now - ring.current.createdAt < ring.rotateEvery) return;
+
+    TicketKey next;
+    if (!generateKey(next)) return;  // 실패하면 기존 키 유지
+    ring.previous = ring.current;
+    ring.current  = next;
+    LOG_INFO("[TlsSessionCache] Session ticket key rotated");
+}
+
+int setHmacKey(EVP_MAC_CTX* hctx, unsigned char* key, size_t len) {
+    OSSL_PARAM params[3];
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key, len);
+    params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                                 const_cast<char*>("SHA256"), 0);
+    params[2] = OSSL_PARAM_construct_end();
+    return EVP_MAC_CTX_set_params(hctx, params);
+}
+
+// 반환값: 1 티켓 사용, 2 사용하되 새 키로 재발급, 0 알 수 없는 키(전체 핸드쉐이크), -1 오류
+int ticketKeyCallback(SSL*, unsigned char keyName[16], unsigned char* iv,
+                      EVP_CIPHER_CTX* cctx, EVP_MAC_CTX* hctx, int enc) {
+    TicketKeyRing& ring = keyRing();
+    ServerMetrics& m = serverMetrics();
+    std::lock_guard<std::mutex> lock(ring.mtx);
+    rotateIfDue(ring);
+
+    if (enc) {
+        TicketKey& key = ring.current;
+        if (!key.valid) return -1;
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1) return -1;
+        memcpy(keyName, key.name, sizeof(key.name));
+        if (!EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, key.aesKey, iv)) return -1;
+        if (!setHmacKey(hctx, key.hmacKey, sizeof(key.hmacKey))) return -1;
+        m.ticketsIssued++;
+        return 1;
+    }
+
+    TicketKey* key = nullptr;
+    bool stale = false;
+    if (ring.current.valid && memcmp(keyName, ring.current.name, 16) == 0) {
+        key = &ring.current;
+    } else if (ring.previous.valid && memcmp(keyName, ring.previous.name, 16) == 0) {
+        key = &ring.previous;
+        stale = true;
+    }
+    if (!key) {
+        m.ticketsUnknownKey++;
+        return 0;
+    }
+    if (!setHmacKey(hctx, key->hmacKey, sizeof(key->hmacKey))) return -1;
+    if (!EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, key->aesKey, iv)) return -1;
+    return stale ? 2 : 1;
+}
+
+#endif
+
+}
+
+void TlsSessionCache::configure(SSL_CTX* ctx, const ServerConfig& cfg) {
+    SSL_CTX_set_session_id_context(ctx, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+
+    // 서버 측 세션 ID 캐시 (티켓을 지원하지 않는 클라이언트, TLS 1.3 stateful 재개)
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(ctx, cfg.sessionCacheSize);
+    SSL_CTX_set_timeout(ctx, cfg.sessionTimeoutSec);
+
+    if (cfg.ticketRotateSec <= 0) {
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+        LOG_INFO("[TlsSessionCache] Session cache ", cfg.sessionCacheSize,
+                 " entries, tickets disabled");
+        return;
+    }
+
+    // TLS 1.3 은 기본으로 티켓 2 장을 보내는데, 재접속은 한 장이면 충분
+    SSL_CTX_set_num_tickets(ctx, 1);
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    {
+        TicketKeyRing& ring = keyRing();
+        std::lock_guard<std::mutex> lock(ring.mtx);
+        ring.rotateEvery = std::chrono::seconds(cfg.ticketRotateSec);
+        rotateIfDue(ring);
+    }
+    SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, ticketKeyCallback);
+    LOG_INFO("[TlsSessionCache] Session cache ", cfg.sessionCacheSize,
+             " entries, ticket key rotation every ", cfg.ticketRotateSec, "s");
+#else
+    // 구버전 OpenSSL: 내장 티켓 키 사용 (프로세스 수명 동안 고정)
+    LOG_INFO("[TlsSessionCache] Session cache ", cfg.sessionCacheSize,
+             " entries, built-in ticket key (no rotation)");
+#endif
+}
+
+void TlsSessionCache::recordHandshake(SSL* ssl) {
+    if (SSL_session_reused(ssl)) {
+        serverMetrics().sessionHits++;
+    } else {
+        serverMetrics().sessionMisses++;
+    }
+}
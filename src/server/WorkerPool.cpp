@@ -0,0 +1,72 @@
+// src/server/WorkerPool.cpp
+
+
+#include "server/WorkerPool.hpp"
+#include "server/ServerMetrics.hpp"
+#include "util/Logger.hpp"
+
+WorkerPool::WorkerPool(size_t threads, size_t queueCapacity)
+  : capacity(queueCapacity), stopping(false) {
+    if (threads == 0) threads = 1;
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+    LOG_INFO("[WorkerPool] ", threads, " worker(s), queue capacity ", capacity);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+bool WorkerPool::trySubmit(std::function<void()> job) {
+    ServerMetrics& m = serverMetrics();
+    size_t depth;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (queue.size() >= capacity) {
+            m.jobsRejected++;
+            return false;
+        }
+        queue.push_back(Job{std::move(job), std::chrono::steady_clock::now()});
+        depth = queue.size();
+    }
+    cv.notify_one();
+
+    m.jobsSubmitted++;
+    m.queueDepth.store(depth, std::memory_order_relaxed);
+    raiseMax(m.queueDepthMax, depth);
+    return true;
+}
+
+size_t WorkerPool::queueDepth() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return queue.size();
+}
+
+void WorkerPool::workerLoop() {
+    ServerMetrics& m = serverMetrics();
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+            m.queueDepth.store(queue.size(), std::memory_order_relaxed);
+        }
+
+        auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - job.enqueuedAt).count();
+        m.queueWaitTotalUs += waitUs;
+        raiseMax(m.queueWaitMaxUs, waitUs);
+
+        job.fn();
+        m.jobsCompleted++;
+    }
+}
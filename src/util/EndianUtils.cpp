@@ -1,4 +1,5 @@
 #include "../../include/util/EndianUtils.hpp"
+#include <cstring>
 
 uint64_t htonll(uint64_t value) {
 #if __BYTE_ORDER == __LITTLE_ENDIAN
@@ -14,4 +15,37 @@ uint64_t ntohll(uint64_t value) {
 #else
     return value;
 #endif
-}
\ No newline at end of file
+}
+
+void writeBE16(void* dst, uint16_t value) {
+    value = htons(value);
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+void writeBE32(void* dst, uint32_t value) {
+    value = htonl(value);
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+void writeBE64(void* dst, uint64_t value) {
+    value = htonll(value);
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+uint16_t readBE16(const void* src) {
+    uint16_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return ntohs(value);
+}
+
+uint32_t readBE32(const void* src) {
+    uint32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return ntohl(value);
+}
+
+uint64_t readBE64(const void* src) {
+    uint64_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return ntohll(value);
+}
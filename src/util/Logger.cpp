@@ -0,0 +1,280 @@
+// src/util/Logger.cpp
+
+#include <openssl/err.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include "util/Logger.hpp"
+
+namespace {
+
+constexpr size_t kFlushBytes = 64 * 1024;  // 이만큼 모이면 write
+constexpr auto   kIdleSleep  = std::chrono::milliseconds(10);
+
+const char* levelName(uint8_t level) {
+    switch (static_cast<LogLevel>(level)) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO ";
+        case LogLevel::Warn:  return "WARN ";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "?    ";
+}
+
+uint64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+uint32_t threadId() {
+    thread_local uint32_t tid = static_cast<uint32_t>(gettid());
+    return tid;
+}
+
+// "YYYY-MM-DD HH:MM:SS.mmm" (현지 시각). 초 단위 부분은 같은 초 동안 재사용
+void appendTimestamp(std::string& out, uint64_t timeNs) {
+    static thread_local time_t cachedSec = -1;
+    static thread_local char   cached[20];
+    time_t sec = static_cast<time_t>(timeNs / 1000000000ull);
+    if (sec != cachedSec) {
+        tm t;
+        localtime_r(&sec, &t);
+        strftime(cached, sizeof(cached), "%Y-%m-%d %H:%M:%S", &t);
+        cachedSec = sec;
+    }
+    char ms[5];
+    snprintf(ms, sizeof(ms), ".%03u", static_cast<unsigned>(timeNs / 1000000ull % 1000));
+    out.append(cached, 19);
+    out.append(ms, 4);
+}
+
+void appendJsonEscaped(std::string& out, const char* text, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x20) {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out.append(esc, 6);
+        } else {
+            out.push_back(static_cast<char>(c));
+        }
+    }
+}
+
+} // namespace
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : slots(new Slot[kSlots]) {
+    for (size_t i = 0; i < kSlots; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+}
+
+bool Logger::start(const LogOptions& options) {
+    if (running.load()) return true;
+    minLevel.store(static_cast<uint8_t>(options.level));
+    rateLimitPerSec.store(options.rateLimit);
+    outFormat = options.format;
+
+    bool ok = true;
+    if (!options.file.empty()) {
+        int f = open(options.file.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (f >= 0) {
+            fd = f;
+        } else {
+            ok = false;
+            logErrno(options.file.c_str());
+        }
+    }
+
+    running.store(true);
+    flusher = std::thread([this] { run(); });
+    return ok;
+}
+
+void Logger::stop() {
+    if (!running.exchange(false)) return;
+    if (flusher.joinable()) flusher.join();
+    // 종료 직전에 들어온 메시지
+    std::string out;
+    while (drainInto(out)) flush(out);
+    flush(out);
+}
+
+// 생산자: 빈 슬롯 하나를 CAS 로 차지해 복사하고 seq 로 공개 (Vyukov 유계 큐)
+void Logger::write(LogLevel level, const char* msg, size_t len) {
+    while (len > 0 && (msg[len - 1] == '\n' || msg[len - 1] == '\r')) --len;
+    if (len > kMaxMessage) len = kMaxMessage;
+
+    if (!running.load(std::memory_order_relaxed)) {
+        writeDirect(level, msg, len);
+        return;
+    }
+
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &slots[pos & (kSlots - 1)];
+        uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // 기록 스레드가 따라오지 못함: 호출 스레드를 막지 않고 버린다
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->timeNs = nowNs();
+    slot->tid    = threadId();
+    slot->level  = static_cast<uint8_t>(level);
+    slot->len    = static_cast<uint16_t>(len);
+    memcpy(slot->text, msg, len);
+    slot->seq.store(pos + 1, std::memory_order_release);
+}
+
+// 공개된 슬롯을 순서대로 포맷해 out 에 붙인다. 하나라도 꺼냈으면 true
+bool Logger::drainInto(std::string& out) {
+    bool any = false;
+    while (out.size() < kFlushBytes) {
+        Slot& slot = slots[tail & (kSlots - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != tail + 1) break;  // 비었거나 복사 중
+        format(out, slot.timeNs, slot.tid, slot.level, slot.text, slot.len);
+        slot.seq.store(tail + kSlots, std::memory_order_release);
+        ++tail;
+        any = true;
+    }
+    return any;
+}
+
+void Logger::format(std::string& out, uint64_t timeNs, uint32_t tid, uint8_t level,
+                    const char* text, size_t len) {
+    written.fetch_add(1, std::memory_order_relaxed);
+    switch (outFormat) {
+        case LogFormat::Text:
+            appendTimestamp(out, timeNs);
+            out.push_back(' ');
+            out.append(levelName(level), 5);
+            out.push_back(' ');
+            out.append(text, len);
+            out.push_back('\n');
+            break;
+        case LogFormat::Json: {
+            const char* name = levelName(level);
+            size_t nameLen = strcspn(name, " ");
+            out.append("{\"ts\":\"");
+            appendTimestamp(out, timeNs);
+            out.append("\",\"level\":\"");
+            for (size_t i = 0; i < nameLen; ++i) out.push_back(static_cast<char>(name[i] | 0x20));
+            out.append("\",\"tid\":");
+            out.append(std::to_string(tid));
+            out.append(",\"msg\":\"");
+            appendJsonEscaped(out, text, len);
+            out.append("\"}\n");
+            break;
+        }
+        case LogFormat::Binary: {
+            char header[16] = {};
+            uint16_t len16 = static_cast<uint16_t>(len);
+            memcpy(header, &timeNs, 8);
+            memcpy(header + 8, &tid, 4);
+            header[12] = static_cast<char>(level);
+            memcpy(header + 14, &len16, 2);
+            out.append(header, sizeof(header));
+            out.append(text, len);
+            break;
+        }
+    }
+}
+
+void Logger::flush(std::string& out) {
+    size_t off = 0;
+    while (off < out.size()) {
+        ssize_t n = ::write(fd, out.data() + off, out.size() - off);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;  // 출력이 닫힘: 버린다
+        off += n;
+    }
+    out.clear();
+}
+
+void Logger::writeDirect(LogLevel level, const char* msg, size_t len) {
+    std::string out;
+    format(out, nowNs(), threadId(), static_cast<uint8_t>(level), msg, len);
+    flush(out);
+}
+
+void Logger::run() {
+    std::string out;
+    out.reserve(kFlushBytes + 1024);
+    auto lastReport = std::chrono::steady_clock::now();
+
+    while (running.load(std::memory_order_relaxed)) {
+        bool any = drainInto(out);
+
+        // 버리거나 제한한 메시지 수를 초당 한 번까지 알린다
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::seconds(1)) {
+            uint64_t d = dropped.load(std::memory_order_relaxed);
+            uint64_t s = suppressed.load(std::memory_order_relaxed);
+            if (d != reportedDropped || s != reportedSuppressed) {
+                char msg[128];
+                int n = snprintf(msg, sizeof(msg), "[Logger] %llu message(s) dropped, %llu suppressed",
+                                 static_cast<unsigned long long>(d - reportedDropped),
+                                 static_cast<unsigned long long>(s - reportedSuppressed));
+                format(out, nowNs(), threadId(), static_cast<uint8_t>(LogLevel::Warn), msg, n);
+                reportedDropped    = d;
+                reportedSuppressed = s;
+            }
+            lastReport = now;
+        }
+
+        if (!out.empty()) flush(out);
+        if (!any) std::this_thread::sleep_for(kIdleSleep);
+    }
+}
+
+bool LogRateLimit::allow() {
+    int limit = Logger::instance().rateLimit();
+    if (limit <= 0) return true;
+
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    int64_t now = ts.tv_sec;
+    int64_t w = window.load(std::memory_order_relaxed);
+    if (w != now && window.compare_exchange_strong(w, now, std::memory_order_relaxed)) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    if (count.fetch_add(1, std::memory_order_relaxed) < static_cast<uint32_t>(limit)) return true;
+    Logger::instance().suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void logErrno(const char* what) {
+    int err = errno;
+    char buf[128];
+    const char* desc = strerror_r(err, buf, sizeof(buf));
+    LOG_ERROR(what, ": ", desc);
+    errno = err;
+}
+
+void logSslErrors() {
+    ERR_print_errors_cb([](const char* str, size_t len, void*) {
+        LOG_ERROR(std::string_view(str, len));
+        return 1;
+    }, nullptr);
+}
@@ -1,12 +1,22 @@
 #include "../../include/server/CommandHandler.hpp"
+#include "../../include/server/CommandTable.hpp"
 #include "../../include/db/DBManager.hpp"
 #include "../../include/db/DBInitializer.hpp"
 #include "../../include/db/repository/HistoryRepository.hpp"
+#include "../../include/server/ImageHandler.hpp"
+#include "../../include/server/ReadBuffer.hpp"
+#include "../../include/server/RequestArena.hpp"
+#include "../../include/server/TimerWheel.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <vector>
 #include <filesystem>  // C++17 이상 필요
 #include <fstream> // 파일 생성용
 
+// TcpServer.cpp 가 참조하는 전역 핸들러
+CommandHandler* commandHandler = nullptr;
 
 int main() {
     // 1. 메모리 DB 연결
@@ -17,7 +27,8 @@ int main() {
     }
 
     DBInitializer::init(db);
-    CommandHandler handler(db.getDB());
+    ImageHandler imageHandler(db.getDB());
+    CommandHandler handler(db.getDB(), &imageHandler);
     HistoryRepository hr(db.getDB());
 
     // 2. REGISTER
@@ -65,6 +76,284 @@ int main() {
     std::cout << "GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE: " << res << std::endl;
     assert(res.find("img3.jpg") != std::string::npos);
 
+    // 10-1. GET_HISTORY_SINCE (커서 이후 행만, 다음 커서 반환)
+    res = handler.handle("GET_HISTORY_SINCE 1 10");
+    std::cout << "GET_HISTORY_SINCE: " << res << std::endl;
+    assert(res.find("img1.jpg") == std::string::npos);
+    assert(res.find("img3.jpg") != std::string::npos);
+    assert(res.find(R"("cursor":3)") != std::string::npos);
+    res = handler.handle("GET_HISTORY_SINCE 3");
+    assert(res.find(R"("data":[])") != std::string::npos && res.find(R"("cursor":3)") != std::string::npos);
+
+    // 10-2. 파이프라인 동시 실행 대상 분류
+    assert(CommandHandler::isReadOnly("GET_HISTORY user@example.com 10 0\n"));
+    assert(CommandHandler::isReadOnly("GET_HISTORY_BY_DATE_RANGE user@example.com 2025-01-01 2025-01-31 10 0"));
+    assert(CommandHandler::isReadOnly("GET_FRAME"));
+    assert(CommandHandler::isReadOnly("GET_LOG\n"));
+    assert(!CommandHandler::isReadOnly("ADD_HISTORY user@example.com"));
+    assert(!CommandHandler::isReadOnly("CHANGE_FRAME 0 1"));
+    assert(!CommandHandler::isReadOnly("GET_IMAGE images/img1.jpg"));
+    assert(CommandHandler::isReadOnly("GET_HISTORY_SINCE 0 10"));
+    assert(!CommandHandler::isReadOnly("GET_HISTORYX user@example.com"));
+
+    // 10-3. 명령 표 (연결 계층과 공유하는 메타데이터)
+    assert(commandId("  UPLOAD a.jpg 10\n") == CommandId::Upload);
+    assert(commandId("UPLOADED a.jpg") == CommandId::Unknown);
+    assert(lookupCommand("GET_HISTORY")->needsAuth);
+    res = handler.handle("GET_HISTORY_PAGE nobody@example.com 10");
+    assert(res.find("404") != std::string::npos);
+    res = handler.handle("GET_STATS nobody@example.com 2025-01-01 2025-01-31");
+    assert(res.find("404") != std::string::npos);
+    res = handler.handle("GET_HISTORY");
+    assert(res.find("400") != std::string::npos);
+    assert(lookupCommand("PROTO")->connection);
+    res = handler.handle("UPLOAD a.jpg 10");
+    assert(res.find("Unknown command") != std::string::npos);
+    res = handler.handle("GET_FRAME " + std::string(1000, 'x'));
+    assert(res.find("413") != std::string::npos);
+    {
+        // 한도를 한 바이트 넘는 배치도 줄 길이 한도 안이라 연결을 끊지 않고 413
+        const CommandInfo* batch = lookupCommand("ADD_HISTORY_BATCH");
+        std::string line = "ADD_HISTORY_BATCH " + std::string(batch->maxPayload + 1, 'x') + "\r\n";
+        assert(line.size() <= ReadBuffer::kMaxLineLength);
+        res = handler.handle(line);
+        assert(res.find("413") != std::string::npos);
+        res = handler.handle("ADD_HISTORY_BATCH " + std::string(batch->maxPayload, 'x'));
+        assert(res.find("413") == std::string::npos);
+    }
+
+    // 10-4. 엄격한 인자 스키마 (형식이 틀리거나 남는 인자는 400)
+    res = handler.handle("GET_HISTORY user@example.com ten 0");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle("GET_HISTORY user@example.com 10 0 extra");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle("GET_HISTORY_SINCE 1x");
+    assert(res.find("400") != std::string::npos);
+    for (const char* cmd : {"GET_FRAME extra", "GET_LOG extra", "GET_METRICS extra"}) {
+        res = handler.handle(cmd);
+        assert(res.find("400") != std::string::npos);
+    }
+    res = handler.handle("GET_METRICS");
+    assert(res.find("success") != std::string::npos);
+    res = handler.handle("ADD_HISTORY 2025-02-01_08:00:00 images/img4.jpg 78라9012 1 - - 61.257");
+    assert(res.find("success") != std::string::npos);
+    res = handler.handle("GET_HISTORY_SINCE 3");
+    assert(res.find(R"("speed":61.2)") != std::string::npos);
+
+    // 10-5. 스트리밍 직렬화: dump() 와 같은 이스케이프, 잘못된 UTF-8 은 500
+    hr.createHistory({"2025-03-01 00:00:00", "images/\"q\x01\\.jpg", "78라9012", 2});
+    res = handler.handle("GET_HISTORY user@example.com 1 0");
+    assert(res == R"({"code":200,"data":[{"date":"2025-03-01 00:00:00","end_snapshot":"","event_type":2,"id":5,)"
+                  R"("image_path":"images/\"q\u0001\\.jpg","plate_number":"78라9012","speed":null,"start_snapshot":""}],)"
+                  R"("message":"History retrieved successfully","status":"success"})");
+    hr.createHistory({"2025-03-02 00:00:00", "images/bad.jpg", "\xff\xfe", 0});
+    res = handler.handle("GET_HISTORY_BY_EVENT_TYPE user@example.com 0 10 0");
+    assert(res.find("500") != std::string::npos);
+
+    // 10-6. ADD_HISTORY_BATCH (한 트랜잭션, 건별 결과)
+    res = handler.handle(R"(ADD_HISTORY_BATCH [{"date":"2025-04-01_09:00:00","image_path":"images/b1.jpg",)"
+                         R"("plate_number":"11가1111","event_type":1,"speed":72.5},{"date":"2025-04-01 09:00:01"},)"
+                         R"({"date":"2025-04-01 09:00:02","image_path":"images/b3.jpg","plate_number":"22나2222","event_type":0}])");
+    std::cout << "ADD_HISTORY_BATCH: " << res << std::endl;
+    assert(res.find(R"({"id":7,"status":"success"},{"message":"Invalid input format","status":"error"},{"id":8,)") != std::string::npos);
+    assert(res.find(R"("failed":1,"inserted":2)") != std::string::npos);
+    res = handler.handle("ADD_HISTORY_BATCH 2025-04-02_10:00:00 images/b4.jpg 33다3333 2\n\n"
+                         "2025-04-02_10:00:01 images/b5.jpg 44라4444 x\n");
+    assert(res.find(R"("data":[{"id":9,"status":"success"},{"message":"Invalid input format","status":"error"}])") != std::string::npos);
+    res = handler.handle("GET_HISTORY_SINCE 6");
+    assert(res.find("b1.jpg") != std::string::npos && res.find(R"("speed":72.5)") != std::string::npos);
+    assert(res.find("b4.jpg") != std::string::npos && res.find(R"("cursor":9)") != std::string::npos);
+    res = handler.handle("ADD_HISTORY_BATCH [1,2");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle(R"(ADD_HISTORY_BATCH [{"date":"2025-04-01_09:00:03","image_path":"images/b6.jpg",)"
+                         R"("plate_number":"11가1111","event_type":4294967296}])");
+    assert(res.find(R"("failed":1,"inserted":0)") != std::string::npos);
+    {
+        // 건 하나의 오류로 SQLite 가 트랜잭션 전체를 되돌리면 (RAISE(ROLLBACK), SQLITE_FULL 등)
+        // 뒤의 건을 자동 커밋으로 흘리지 않고 묶음 전체를 실패로 끝낸다
+        DBManager rbDb(":memory:");
+        assert(rbDb.open());
+        DBInitializer::init(rbDb);
+        rbDb.execute("CREATE TRIGGER abort_batch BEFORE INSERT ON history WHEN NEW.plate_number = 'rollback' "
+                     "BEGIN SELECT RAISE(ROLLBACK, 'rollback'); END;");
+        HistoryRepository rbRepo(rbDb.getDB());
+        std::vector<History> batch(5, History{"2025-04-03 00:00:00", "images/rb.jpg", "1", 0});
+        batch[2].plateNumber = "rollback";
+        std::vector<int> ids;
+        assert(!rbRepo.createHistories(batch, ids));
+        assert(std::count(ids.begin(), ids.end(), -1) == static_cast<long>(ids.size()));
+        sqlite3_stmt* stmt;
+        sqlite3_prepare_v2(rbDb.getDB(), "SELECT COUNT(*) FROM history;", -1, &stmt, nullptr);
+        assert(sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_int(stmt, 0) == 0);
+        sqlite3_finalize(stmt);
+    }
+
+    // 10-7. *_PAGE 키셋 페이지 (같은 시각 행은 id 로 이어서)
+    hr.createHistory({"2025-05-01 08:00:00", "images/t10.jpg", "55마5555", 0});
+    hr.createHistory({"2025-05-01 08:00:00", "images/t11.jpg", "66바6666", 2});
+    hr.createHistory({"2025-05-01 08:00:00", "images/t12.jpg", "77사7777", 0});
+    res = handler.handle("GET_HISTORY_PAGE user@example.com 2");
+    std::cout << "GET_HISTORY_PAGE: " << res << std::endl;
+    assert(res.find("t12.jpg") != std::string::npos && res.find("t11.jpg") != std::string::npos);
+    assert(res.find(R"("next_cursor":"2025-05-01_08:00:00,11")") != std::string::npos);
+    res = handler.handle("GET_HISTORY_PAGE user@example.com 2 2025-05-01_08:00:00,11");
+    assert(res.find(R"("id":10,)") != std::string::npos && res.find(R"("id":9,)") != std::string::npos);
+    assert(res.find(R"("next_cursor":"2025-04-02_10:00:00,9")") != std::string::npos);
+    res = handler.handle("GET_HISTORY_BY_EVENT_TYPE_PAGE user@example.com 0 1 2025-05-01_08:00:00,12");
+    assert(res.find("t10.jpg") != std::string::npos && res.find("t12.jpg") == std::string::npos);
+    res = handler.handle("GET_HISTORY_BY_DATE_RANGE_PAGE user@example.com 2025-01-01 2025-01-31 10");
+    assert(res.find("img3.jpg") != std::string::npos && res.find(R"("next_cursor":null)") != std::string::npos);
+    res = handler.handle("GET_HISTORY_BY_EVENT_TYPE_AND_DATE_RANGE_PAGE user@example.com 0 2025-01-01 2025-01-31 1");
+    assert(res.find("img3.jpg") != std::string::npos && res.find(R"("next_cursor":"2025-01-20_12:00:00,3")") != std::string::npos);
+    res = handler.handle("GET_HISTORY_PAGE user@example.com 2 2025-05-01");
+    assert(res.find("400") != std::string::npos);
+    assert(hr.getHistories(10, 0, [](const HistoryRow&) { return false; }));  // 호출자가 멈춘 것은 실패가 아니다
+    {
+        // SQLite 가 읽다가 실패하면 일부 행으로 성공 응답 (cursor, next_cursor) 을 만들지 않고 500
+        DBManager badDb(":memory:");
+        assert(badDb.open());
+        DBInitializer::init(badDb);
+        badDb.execute("DROP TABLE history;"
+                      "CREATE VIEW history AS SELECT 1 AS id, json('{') AS date, 'a.jpg' AS image_path, "
+                      "'1' AS plate_number, 0 AS event_type, NULL AS start_snapshot, NULL AS end_snapshot, NULL AS speed;");
+        ImageHandler badImages(badDb.getDB());
+        CommandHandler badHandler(badDb.getDB(), &badImages);
+        badHandler.handle("REGISTER bad@example.com pw");
+        for (const char* cmd : {"GET_HISTORY bad@example.com", "GET_HISTORY_PAGE bad@example.com 10", "GET_HISTORY_SINCE 0"}) {
+            res = badHandler.handle(cmd);
+            assert(res.find(R"("code": 500, "message": "Failed to read history")") != std::string::npos);
+        }
+    }
+
+    // 10-8. GET_STATS (롤업은 INSERT/DELETE 트리거로 유지)
+    res = handler.handle("GET_STATS user@example.com 2025-05-01 2025-05-01");
+    std::cout << "GET_STATS: " << res << std::endl;
+    assert(res.find(R"("data":[{"counts":{"0":2,"2":1},"period":"2025-05-01","total":3}])") != std::string::npos);
+    assert(hr.deleteHistory(12));
+    res = handler.handle("GET_STATS user@example.com 2025-01-01 2025-05-31 hour");
+    assert(res.find(R"({"counts":{"0":1},"period":"2025-01-20 12:00","total":1})") != std::string::npos);
+    assert(res.find(R"({"counts":{"0":1,"2":1},"period":"2025-05-01 08:00","total":2})") != std::string::npos);
+    res = handler.handle("GET_STATS user@example.com 2025-01-01 2025-05-31 week");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle("GET_STATS user@example.com abc zzz");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle("GET_STATS user@example.com 2025-13-01 2025-13-31");
+    assert(res.find("400") != std::string::npos);
+    res = handler.handle("GET_HISTORY_BY_DATE_RANGE user@example.com 2025-01-01 2025/01/31");
+    assert(res.find("400") != std::string::npos);
+    // 건수 0 인 행이 섞여도 기간 원소가 올바르게 열리고 닫힌다
+    db.execute("INSERT INTO history_stats (hour, event_type, count) VALUES ('2025-07-01 00', 0, 0), ('2025-07-01 01', 1, 2);");
+    res = handler.handle("GET_STATS user@example.com 2025-07-01 2025-07-01 hour");
+    assert(res.find(R"("data":[{"counts":{"0":0},"period":"2025-07-01 00:00","total":0},)"
+                    R"({"counts":{"1":2},"period":"2025-07-01 01:00","total":2}])") != std::string::npos);
+    {
+        // 롤업 이전에 만든 DB 는 처음 초기화할 때 기존 행으로 채운다
+        DBManager oldDb(":memory:");
+        assert(oldDb.open());
+        oldDb.execute("CREATE TABLE history (id INTEGER PRIMARY KEY, date DATETIME NOT NULL, image_path TEXT NOT NULL, "
+                      "plate_number TEXT NOT NULL, event_type INTEGER NOT NULL, start_snapshot TEXT, end_snapshot TEXT, speed FLOAT);"
+                      "INSERT INTO history (date, image_path, plate_number, event_type) VALUES "
+                      "('2025-06-01 10:00:00', 'a.jpg', '1', 1), ('2025-06-01 11:00:00', 'b.jpg', '2', 1);");
+        DBInitializer::init(oldDb);
+        DBInitializer::init(oldDb);  // 두 번째는 다시 채우지 않는다
+        HistoryRepository oldRepo(oldDb.getDB());
+        long long count = 0;
+        oldRepo.getStats("2025-06-01", "2025-06-01", false, [&](const HistoryStatsRow& row) {
+            count += row.count;
+            return true;
+        });
+        assert(count == 2);
+    }
+
+    // 10-9. ReadBuffer: 두 번에 나눠 들어온 줄, 훑은 구간보다 많이 소비, 앞당기기 뒤 줄 찾기
+    {
+        ReadBuffer rb(8);
+        auto append = [&rb](const char* s) {
+            size_t n = std::strlen(s);
+            std::memcpy(rb.prepareWrite(n), s, n);
+            rb.commit(n);
+        };
+        append("AB C");
+        assert(rb.findLine() == 0);
+        append("D\nEF");                      // 공간이 모자라 버퍼가 커진다
+        assert(rb.findLine() == 6);
+        rb.consume(6);
+        assert(rb.size() == 2 && rb.findLine() == 0);
+        rb.consume(1);                        // 훑은 구간 안에서 소비
+        assert(rb.findLine() == 0);
+        append("G\nH");
+        assert(rb.findLine() == 3);           // "FG\n"
+        rb.consume(3);                        // 훑은 구간보다 많이 소비
+        assert(rb.findLine() == 0 && rb.size() == 1);
+        append("IJ");
+        assert(rb.findLine() == 0);
+        rb.prepareWrite(rb.writable() + 1);   // 읽은 앞부분을 당겨도 훑은 길이는 그대로 유효
+        append("\n");
+        assert(rb.findLine() == 4 && std::memcmp(rb.data(), "HIJ\n", 4) == 0);
+        char out[8];
+        assert(rb.take(out, sizeof(out)) == 4 && rb.empty());
+        rb.release();
+        append("K\n");                        // 반납 뒤 다시 할당
+        assert(rb.findLine() == 2);
+    }
+
+    // 10-10. TimerWheel: 한 바퀴보다 먼 마감, 오래 멈췄다 깨어남, 만료 뒤 취소
+    // (시각은 생성 직후 기준 + tick 경계에서 떨어진 값이라 실행 속도와 무관)
+    {
+        using namespace std::chrono_literals;
+        TimerWheel wheel(10ms, 4);
+        auto base = TimerWheel::Clock::now();
+        std::vector<uint64_t> expired;
+        assert(wheel.nextTimeoutMs(base) == -1);
+
+        wheel.schedule(1, base + 25ms);
+        wheel.advance(base + 15ms, expired);
+        assert(expired.empty());
+        wheel.advance(base + 35ms, expired);
+        assert(expired == std::vector<uint64_t>{1});
+
+        expired.clear();
+        wheel.schedule(2, base + 105ms);      // slots*tick 보다 멀다: 같은 칸을 한 번 지나친 뒤 만료
+        wheel.advance(base + 75ms, expired);
+        assert(expired.empty() && !wheel.empty());
+        wheel.advance(base + 115ms, expired);
+        assert(expired == std::vector<uint64_t>{2});
+
+        expired.clear();
+        wheel.schedule(3, base + 135ms);
+        wheel.schedule(4, base + 175ms);
+        wheel.schedule(5, base + 9000ms);
+        wheel.advance(base + 505ms, expired);  // 한 바퀴 이상 건너뛰어도 지난 마감은 모두
+        assert(expired.size() == 2 && expired[0] + expired[1] == 7);
+        assert(!wheel.empty());
+
+        expired.clear();
+        wheel.schedule(5, base + 515ms);      // 교체
+        wheel.schedule(6, base + 525ms);
+        wheel.cancel(6);
+        wheel.advance(base + 535ms, expired);
+        assert(expired == std::vector<uint64_t>{5} && wheel.empty());
+        wheel.cancel(5);                      // 만료 뒤 취소는 아무 일도 하지 않는다
+        wheel.schedule(7, base + 100ms);      // 이미 지난 마감은 다음 검사 때
+        wheel.advance(base + 545ms, expired);
+        assert(expired.back() == 7 && wheel.empty());
+    }
+
+    // 10-11. ArenaAllocator: 해제는 Scope 가 아니라 블록 출처로 (요청 밖 값을 안에서, 안 값을 밖에서)
+    {
+        auto* outside = new ArenaString(1000, 'o');  // 요청 밖: 힙
+        ArenaString* inside = nullptr;
+        {
+            RequestArena::Scope scope;
+            inside = new ArenaString(1000, 'i');     // 요청 안: 아레나
+            ArenaString big(RequestArena::kInitialSize * 2, 'b');  // 초기 버퍼를 넘어 힙에서 더 받은 블록
+            assert(RequestArena::owns(inside->data()) && RequestArena::owns(big.data()));
+            assert(!RequestArena::owns(outside->data()));
+            delete outside;  // 힙 블록은 요청 안에서도 힙으로
+        }
+        delete inside;       // 아레나 블록은 요청 밖에서 해제해도 힙으로 보내지 않는다
+    }
+
     // 11. 이미지 더미 파일 생성
     std::filesystem::create_directories("images");
     std::ofstream("images/img1.jpg");  // 빈 파일 생성